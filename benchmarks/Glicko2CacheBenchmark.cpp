@@ -0,0 +1,269 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Rating cache contention benchmark
+ *
+ *   BM_CacheMixed   7 lookups and 1 rating write per iteration from 1..8
+ *                   threads (one per MapUpdate.Threads worker), each on its
+ *                   own players, against 1 shard (the old storage-wide lock)
+ *                   and the default 16 shards
+ *   BM_CacheRead    matchmaking lookups of rating and RD from 1..8 threads:
+ *                   shared_lock on a 16-shard cache against the lock-free
+ *                   Glicko2RatingIndex the storages keep beside it
+ *
+ *   BM_MapLookup    random hits in 100k and 1M cached ratings, with the
+ *                   map's bytes per entry as a counter: the flat
+ *                   Glicko2FlatMap the shards use against the node-based
+ *                   std::unordered_map they used before (node bytes leave
+ *                   out malloc's own per-allocation header)
+ *
+ * The storages themselves need the worldserver, so this drives the same
+ * Glicko2ShardedCache with a value the size of a cached BG rating.
+ */
+
+#include "Glicko2RatingIndex.h"
+#include "Glicko2ShardedCache.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint64_t CACHED_PLAYERS = 20000;
+
+    /// Stand-in for Glicko2PlayerStorage::CacheEntry
+    struct CachedRating
+    {
+        float rating = 1500.0f;
+        float ratingDeviation = 350.0f;
+        float volatility = 0.06f;
+        uint32_t matchesPlayed = 0;
+        uint32_t wins = 0;
+        uint32_t losses = 0;
+        uint32_t lastMatchTime = 0;
+        uint32_t version = 0;
+        uint32_t savedVersion = 0;
+    };
+
+    using RatingCache = Glicko2ShardedCache<uint64_t, CachedRating>;
+
+    /// Counts the bytes a standard container allocates
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        explicit CountingAllocator(std::size_t* bytes) : bytes(bytes) { }
+
+        template <typename U>
+        CountingAllocator(CountingAllocator<U> const& other) : bytes(other.bytes) { }
+
+        T* allocate(std::size_t count)
+        {
+            *bytes += count * sizeof(T);
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* pointer, std::size_t count)
+        {
+            *bytes -= count * sizeof(T);
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template <typename U>
+        bool operator==(CountingAllocator<U> const& other) const { return bytes == other.bytes; }
+
+        std::size_t* bytes;
+    };
+
+    RatingCache& GetCache(std::size_t shards)
+    {
+        static std::array<RatingCache, 2> caches = { RatingCache(1), RatingCache(RatingCache::DEFAULT_SHARDS) };
+        static bool const filled = []
+        {
+            for (RatingCache& cache : caches)
+                for (uint64_t guid = 1; guid <= CACHED_PLAYERS; ++guid)
+                    cache.GetShard(guid).map.emplace(guid, CachedRating());
+
+            return true;
+        }();
+        (void)filled;
+
+        return caches[shards == 1 ? 0 : 1];
+    }
+
+    void BM_CacheMixed(benchmark::State& state)
+    {
+        RatingCache& cache = GetCache(static_cast<std::size_t>(state.range(0)));
+
+        // Each map thread rates its own players, as battlegrounds on different maps do
+        uint64_t threads = static_cast<uint64_t>(state.threads());
+        uint64_t perThread = CACHED_PLAYERS / threads;
+        uint64_t first = static_cast<uint64_t>(state.thread_index()) * perThread + 1;
+
+        std::mt19937_64 rng(first);
+        std::uniform_int_distribution<uint64_t> pick(first, first + perThread - 1);
+
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < 7; ++i)
+            {
+                uint64_t guid = pick(rng);
+                RatingCache::Shard const& shard = cache.GetShard(guid);
+                std::shared_lock lock(shard.mutex);
+
+                auto itr = shard.map.find(guid);
+                if (itr != shard.map.end())
+                    sum += itr->second.rating;
+            }
+
+            uint64_t guid = pick(rng);
+            RatingCache::Shard& shard = cache.GetShard(guid);
+            {
+                std::unique_lock lock(shard.mutex);
+                CachedRating& entry = shard.map[guid];
+                entry.rating += 1.0f;
+                ++entry.version;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * 8);
+        state.counters["shards"] = benchmark::Counter(static_cast<double>(cache.GetShardCount()), benchmark::Counter::kAvgThreads);
+    }
+
+    Glicko2RatingIndex& GetIndex()
+    {
+        static Glicko2RatingIndex index;
+        static bool const filled = []
+        {
+            Glicko2RatingSnapshot snapshot;
+            snapshot.rating = 1500.0f;
+            snapshot.ratingDeviation = 350.0f;
+            for (uint64_t guid = 1; guid <= CACHED_PLAYERS; ++guid)
+                index.Publish(guid, snapshot);
+
+            return true;
+        }();
+
+        (void)filled;
+        return index;
+    }
+
+    /// Queue scoring: every thread looks up the same pool of players
+    void BM_CacheRead(benchmark::State& state)
+    {
+        bool lockFree = state.range(0) != 0;
+        RatingCache& cache = GetCache(RatingCache::DEFAULT_SHARDS);
+        Glicko2RatingIndex& index = GetIndex();
+
+        std::mt19937_64 rng(static_cast<uint64_t>(state.thread_index()) + 1);
+        std::uniform_int_distribution<uint64_t> pick(1, CACHED_PLAYERS);
+
+        for (auto _ : state)
+        {
+            uint64_t guid = pick(rng);
+            float rating = 0.0f;
+
+            if (lockFree)
+            {
+                Glicko2RatingSnapshot snapshot;
+                if (index.Find(guid, snapshot))
+                    rating = snapshot.rating + snapshot.ratingDeviation;
+            }
+            else
+            {
+                RatingCache::Shard const& shard = cache.GetShard(guid);
+                std::shared_lock lock(shard.mutex);
+
+                auto itr = shard.map.find(guid);
+                if (itr != shard.map.end())
+                    rating = itr->second.rating + itr->second.ratingDeviation;
+            }
+
+            benchmark::DoNotOptimize(rating);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(lockFree ? "rating index" : "shared_lock");
+    }
+
+
+    /// GUID counters as handed out to characters: dense, in creation order
+    std::vector<uint32_t> MakeLookups(uint32_t entries)
+    {
+        std::mt19937 rng(entries);
+        std::uniform_int_distribution<uint32_t> pick(1, entries);
+
+        std::vector<uint32_t> lookups(4096);
+        for (uint32_t& guid : lookups)
+            guid = pick(rng);
+
+        return lookups;
+    }
+
+    template <bool Flat>
+    void BM_MapLookup(benchmark::State& state)
+    {
+        uint32_t entries = static_cast<uint32_t>(state.range(0));
+        std::vector<uint32_t> lookups = MakeLookups(entries);
+
+        std::size_t bytes = 0;
+        Glicko2FlatMap<uint32_t, CachedRating> flat;
+        std::unordered_map<uint64_t, CachedRating, std::hash<uint64_t>, std::equal_to<uint64_t>,
+            CountingAllocator<std::pair<uint64_t const, CachedRating>>> node{ CountingAllocator<std::pair<uint64_t const, CachedRating>>(&bytes) };
+
+        for (uint32_t guid = 1; guid <= entries; ++guid)
+        {
+            if constexpr (Flat)
+                flat.try_emplace(guid);
+            else
+                node.try_emplace(guid);
+        }
+
+        std::size_t next = 0;
+        for (auto _ : state)
+        {
+            uint32_t guid = lookups[next++ & (lookups.size() - 1)];
+            float rating = 0.0f;
+
+            if constexpr (Flat)
+                rating = flat.find(guid)->second.rating;
+            else
+                rating = node.find(guid)->second.rating;
+
+            benchmark::DoNotOptimize(rating);
+        }
+
+        std::size_t memory = Flat ? flat.GetMemoryUsage() : bytes;
+        state.SetItemsProcessed(state.iterations());
+        state.counters["bytes_per_entry"] = static_cast<double>(memory) / entries;
+        state.counters["MiB"] = static_cast<double>(memory) / (1024.0 * 1024.0);
+    }
+
+}
+
+BENCHMARK(BM_CacheMixed)->Arg(1)->Arg(16)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK(BM_CacheRead)->Arg(0)->Arg(1)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MapLookup, true)->Arg(100000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_MapLookup, false)->Arg(100000)->Arg(1000000);
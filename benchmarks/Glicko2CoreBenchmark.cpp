@@ -0,0 +1,261 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Glicko-2 core benchmark suite
+ *
+ * Covers the update shapes the module runs in production:
+ *   BM_SingleUpdate     one player, one result (arena 2v2 style)
+ *   BM_TeamUpdate       a whole team against the averaged enemy side, as
+ *                       Glicko2BGScript does at match end (5/10/15/40 players)
+ *   BM_RatingPeriod     one player against 5/10/15/40 individual results,
+ *                       as committed at the end of a rating period
+ *   BM_InactiveUpdate   one idle period, and the closed form over many
+ *   BM_VolatilitySolve  step 5 worst cases in both solver modes, with the
+ *                       f(x) evaluation counts reported as counters
+ *   BM_WinProbability   matchmaking predictions for 16..1024 candidate
+ *                       pairings, batched against one call per pairing
+ *
+ * Build and run through the standalone CMake project (see CMakeLists.txt):
+ *   cmake --build build --target glicko2_benchmark_json
+ * The JSON written to build/glicko2_benchmarks.json can be diffed across
+ * commits with Google Benchmark's tools/compare.py.
+ */
+
+#include "Glicko2.h"
+#include "Glicko2Simd.h"
+#include "Glicko2Solver.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace
+{
+    /// Volatility solver stress cases, index = benchmark argument
+    struct SolveCase
+    {
+        char const* name;
+        Glicko2Rating player;
+        Glicko2Opponent opponent;
+        size_t results;
+    };
+
+    SolveCase const SOLVE_CASES[] =
+    {
+        { "typical",         Glicko2Rating(1500.0f, 200.0f, 0.06f),      Glicko2Opponent(1550.0f, 100.0f, 1.0f),  3 },
+        { "huge upset",      Glicko2Rating(800.0f, 30.0f, 0.03f),        Glicko2Opponent(2800.0f, 30.0f, 1.0f),   20 },
+        { "expected only",   Glicko2Rating(2800.0f, 30.0f, 0.06f),       Glicko2Opponent(800.0f, 30.0f, 1.0f),    20 },
+        { "volatile",        Glicko2Rating(1500.0f, 350.0f, 0.3f),       Glicko2Opponent(1500.0f, 350.0f, 0.0f),  1 },
+        { "stalled bracket", Glicko2Rating(3192.6f, 245.1f, 0.09356f),   Glicko2Opponent(825.5f, 140.7f, 0.0f),   28 },
+    };
+
+    std::vector<Glicko2Opponent> MakeOpponents(size_t count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> rating(1200.0f, 2200.0f);
+        std::uniform_real_distribution<float> rd(40.0f, 350.0f);
+
+        std::vector<Glicko2Opponent> opponents;
+        opponents.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            opponents.emplace_back(rating(rng), rd(rng), (i % 2) ? 1.0f : 0.0f);
+
+        return opponents;
+    }
+
+    void AddIsaContext()
+    {
+        static bool added = false;
+        if (added)
+            return;
+
+        benchmark::AddCustomContext("glicko2_isa", Glicko2Simd::GetIsaName(Glicko2Simd::GetActiveIsa()));
+        added = true;
+    }
+
+    void BM_SingleUpdate(benchmark::State& state)
+    {
+        AddIsaContext();
+
+        Glicko2System system(0.5f);
+        Glicko2Rating player(1650.0f, 120.0f, 0.06f);
+        std::vector<Glicko2Opponent> opponents = { Glicko2Opponent(1580.0f, 90.0f, 1.0f) };
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateRating(player, opponents));
+    }
+
+    void BM_TeamUpdate(benchmark::State& state)
+    {
+        AddIsaContext();
+
+        size_t count = static_cast<size_t>(state.range(0));
+        Glicko2System system(0.5f);
+        Glicko2PreparedOpponent enemySide = system.PrepareOpponent(Glicko2Opponent(1620.0f, 140.0f, 1.0f));
+
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> rating(1200.0f, 2200.0f);
+        std::uniform_real_distribution<float> rd(40.0f, 350.0f);
+
+        std::vector<float> startRatings(count), startRDs(count), startVols(count, 0.06f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            startRatings[i] = rating(rng);
+            startRDs[i] = rd(rng);
+        }
+
+        std::vector<float> ratings(count), rds(count), vols(count);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ratings = startRatings;
+            rds = startRDs;
+            vols = startVols;
+            state.ResumeTiming();
+
+            system.UpdateRatingsBatch({ ratings, rds, vols }, enemySide);
+            benchmark::DoNotOptimize(ratings.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+        state.counters["players"] = static_cast<double>(count);
+    }
+
+    void BM_RatingPeriod(benchmark::State& state)
+    {
+        AddIsaContext();
+
+        Glicko2System system(0.5f);
+        Glicko2Rating player(1650.0f, 120.0f, 0.06f);
+        std::vector<Glicko2Opponent> opponents = MakeOpponents(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateRating(player, opponents));
+
+        state.counters["opponents"] = static_cast<double>(opponents.size());
+    }
+
+    void BM_InactiveUpdate(benchmark::State& state)
+    {
+        Glicko2System system(0.5f);
+        Glicko2Rating player(1650.0f, 60.0f, 0.06f);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateInactiveRating(player));
+    }
+
+    void BM_InactiveUpdateClosedForm(benchmark::State& state)
+    {
+        Glicko2System system(0.5f);
+        Glicko2Rating player(1650.0f, 60.0f, 0.06f);
+        uint32_t periods = static_cast<uint32_t>(state.range(0));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateInactiveRating(player, periods, 350.0f));
+
+        state.counters["periods"] = static_cast<double>(periods);
+    }
+
+    std::vector<Glicko2Rating> MakeTeams(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> rating(1200.0f, 2200.0f);
+        std::uniform_real_distribution<float> rd(40.0f, 350.0f);
+
+        std::vector<Glicko2Rating> teams;
+        teams.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            teams.emplace_back(rating(rng), rd(rng), 0.06f);
+
+        return teams;
+    }
+
+    void BM_WinProbability(benchmark::State& state)
+    {
+        AddIsaContext();
+
+        size_t count = static_cast<size_t>(state.range(0));
+        Glicko2System system(0.5f);
+        std::vector<Glicko2Rating> teamsA = MakeTeams(count, 5);
+        std::vector<Glicko2Rating> teamsB = MakeTeams(count, 6);
+        std::vector<float> results(count);
+
+        for (auto _ : state)
+        {
+            system.WinProbability(teamsA, teamsB, results);
+            benchmark::DoNotOptimize(results.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    }
+
+    void BM_WinProbabilityPerPair(benchmark::State& state)
+    {
+        size_t count = static_cast<size_t>(state.range(0));
+        Glicko2System system(0.5f);
+        std::vector<Glicko2Rating> teamsA = MakeTeams(count, 5);
+        std::vector<Glicko2Rating> teamsB = MakeTeams(count, 6);
+        std::vector<float> results(count);
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; ++i)
+                results[i] = system.WinProbability(teamsA[i], teamsB[i]);
+            benchmark::DoNotOptimize(results.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    }
+
+    template <Glicko2SolverMode Mode>
+    void BM_VolatilitySolve(benchmark::State& state)
+    {
+        SolveCase const& solveCase = SOLVE_CASES[state.range(0)];
+        state.SetLabel(solveCase.name);
+
+        Glicko2SolverOptions options;
+        options.mode = Mode;
+
+        Glicko2System system(0.5f);
+        system.SetSolverOptions(options);
+        std::vector<Glicko2Opponent> opponents(solveCase.results, solveCase.opponent);
+
+        sGlicko2SolverStats->Reset();
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateRating(solveCase.player, opponents));
+
+        // Mean Illinois iterations; the histogram's last bucket counts as BUCKETS - 1
+        Glicko2SolverStats::Snapshot stats = sGlicko2SolverStats->GetSnapshot();
+        uint64_t iterations = 0;
+        for (size_t bucket = 0; bucket < stats.iterations.size(); ++bucket)
+            iterations += bucket * stats.iterations[bucket];
+
+        double calls = static_cast<double>(stats.calls ? stats.calls : 1);
+        state.counters["iterations"] = static_cast<double>(iterations) / calls;
+        state.counters["evaluations"] = static_cast<double>(stats.maxEvaluations);
+        state.counters["capped"] = static_cast<double>(stats.capped) / calls;
+    }
+}
+
+BENCHMARK(BM_SingleUpdate);
+BENCHMARK(BM_TeamUpdate)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
+BENCHMARK(BM_RatingPeriod)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
+BENCHMARK(BM_InactiveUpdate);
+BENCHMARK(BM_InactiveUpdateClosedForm)->Arg(1)->Arg(4)->Arg(52);
+BENCHMARK_TEMPLATE(BM_VolatilitySolve, Glicko2SolverMode::Reference)->DenseRange(0, std::size(SOLVE_CASES) - 1);
+BENCHMARK_TEMPLATE(BM_VolatilitySolve, Glicko2SolverMode::WarmStart)->DenseRange(0, std::size(SOLVE_CASES) - 1);
+BENCHMARK(BM_WinProbability)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_WinProbabilityPerPair)->RangeMultiplier(4)->Range(16, 1024);
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Opponent kernel microbenchmark
+ *
+ * Compares the three-pass opponent walk (variance, delta, step 7) that
+ * Glicko2System::UpdateRating used to perform with the fused single-pass
+ * kernel. Both kernels count their exp/sqrt calls and report them as
+ * per-update counters next to the timings. BM_UpdateRating runs the
+ * runtime-configurable system and BM_UpdateRatingStatic the compile-time
+ * specialized Glicko2DefaultSystem on the same inputs.
+ *
+ * Built into glicko2_benchmarks by the standalone CMake project (see CMakeLists.txt).
+ */
+
+#include "Glicko2.h"
+#include "Glicko2Static.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace
+{
+    constexpr float SCALE_FACTOR = 173.7178f;
+    constexpr float PI_SQUARED = 9.8696044f;
+
+    uint64_t expCalls = 0;
+    uint64_t sqrtCalls = 0;
+
+    float CountedExp(float x)
+    {
+        ++expCalls;
+        return std::exp(x);
+    }
+
+    float CountedSqrt(float x)
+    {
+        ++sqrtCalls;
+        return std::sqrt(x);
+    }
+
+    float G(float phi)
+    {
+        return 1.0f / CountedSqrt(1.0f + (3.0f * phi * phi) / PI_SQUARED);
+    }
+
+    /// Pre-fusion E(): recomputes g(φj) internally
+    float E(float mu, float muJ, float phiJ)
+    {
+        return 1.0f / (1.0f + CountedExp(-G(phiJ) * (mu - muJ)));
+    }
+
+    std::vector<Glicko2Opponent> MakeOpponents(size_t count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> rating(1200.0f, 2200.0f);
+        std::uniform_real_distribution<float> rd(40.0f, 350.0f);
+
+        std::vector<Glicko2Opponent> opponents;
+        opponents.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            opponents.emplace_back(rating(rng), rd(rng), (i % 2) ? 1.0f : 0.0f);
+
+        return opponents;
+    }
+
+    /// Kernel shape of UpdateRating before fusion: three walks over the opponents
+    float ThreePassKernel(float mu, std::vector<Glicko2Opponent> const& opponents)
+    {
+        float varianceSum = 0.0f;
+        for (auto const& o : opponents)
+        {
+            float muJ = (o.rating - 1500.0f) / SCALE_FACTOR;
+            float phiJ = o.ratingDeviation / SCALE_FACTOR;
+            float g = G(phiJ);
+            float e = E(mu, muJ, phiJ);
+            varianceSum += g * g * e * (1.0f - e);
+        }
+
+        float deltaSum = 0.0f;
+        for (auto const& o : opponents)
+        {
+            float muJ = (o.rating - 1500.0f) / SCALE_FACTOR;
+            float phiJ = o.ratingDeviation / SCALE_FACTOR;
+            float g = G(phiJ);
+            float e = E(mu, muJ, phiJ);
+            deltaSum += g * (o.score - e);
+        }
+
+        float muSum = 0.0f;
+        for (auto const& o : opponents)
+        {
+            float muJ = (o.rating - 1500.0f) / SCALE_FACTOR;
+            float phiJ = o.ratingDeviation / SCALE_FACTOR;
+            muSum += G(phiJ) * (o.score - E(mu, muJ, phiJ));
+        }
+
+        return varianceSum + deltaSum + muSum;
+    }
+
+    /// Kernel shape of UpdateRating after fusion: one walk, g and E reused
+    float FusedKernel(float mu, std::vector<Glicko2Opponent> const& opponents)
+    {
+        float varianceSum = 0.0f;
+        float deltaSum = 0.0f;
+        for (auto const& o : opponents)
+        {
+            float muJ = (o.rating - 1500.0f) / SCALE_FACTOR;
+            float g = G(o.ratingDeviation / SCALE_FACTOR);
+            float e = 1.0f / (1.0f + CountedExp(-g * (mu - muJ)));
+            varianceSum += g * g * e * (1.0f - e);
+            deltaSum += g * (o.score - e);
+        }
+
+        return varianceSum + deltaSum;
+    }
+
+    template <float (*Kernel)(float, std::vector<Glicko2Opponent> const&)>
+    void BM_OpponentKernel(benchmark::State& state)
+    {
+        std::vector<Glicko2Opponent> opponents = MakeOpponents(static_cast<size_t>(state.range(0)));
+        expCalls = 0;
+        sqrtCalls = 0;
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Kernel(0.25f, opponents));
+
+        double iterations = static_cast<double>(state.iterations());
+        state.counters["exp/update"] = static_cast<double>(expCalls) / iterations;
+        state.counters["sqrt/update"] = static_cast<double>(sqrtCalls) / iterations;
+        state.counters["opponents"] = static_cast<double>(opponents.size());
+    }
+
+    void BM_UpdateRating(benchmark::State& state)
+    {
+        Glicko2System system(0.5f);
+        Glicko2Rating player(1650.0f, 120.0f, 0.06f);
+        std::vector<Glicko2Opponent> opponents = MakeOpponents(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateRating(player, opponents));
+
+        state.counters["opponents"] = static_cast<double>(opponents.size());
+    }
+
+    void BM_UpdateRatingStatic(benchmark::State& state)
+    {
+        Glicko2DefaultSystem system;
+        Glicko2Rating player(1650.0f, 120.0f, 0.06f);
+        std::vector<Glicko2Opponent> opponents = MakeOpponents(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(system.UpdateRating(player, opponents));
+
+        state.counters["opponents"] = static_cast<double>(opponents.size());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_OpponentKernel, ThreePassKernel)->Arg(1)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
+BENCHMARK_TEMPLATE(BM_OpponentKernel, FusedKernel)->Arg(1)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
+BENCHMARK(BM_UpdateRating)->Arg(1)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
+BENCHMARK(BM_UpdateRatingStatic)->Arg(1)->Arg(5)->Arg(10)->Arg(15)->Arg(40);
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Glicko-2 SQL statement benchmark
+ *
+ * Client-side cost of producing the BG rating save statement:
+ *   BM_StatementFormat    fmt::format over the runtime format string, as the
+ *                         storages did before the statement registry
+ *                         (only built when fmt is found)
+ *   BM_StatementBuilder   Glicko2SqlBuilder: typed SetData() calls rendering
+ *                         each value, and GetSql() splicing them in
+ *
+ * Server-side parsing is the same for both: AzerothCore does not let modules
+ * prepare statements on its connections, so both reach MySQL as text.
+ */
+
+#include "Glicko2Statements.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+#ifdef GLICKO2_BENCHMARK_FMT
+#include <fmt/format.h>
+#endif
+
+namespace
+{
+    struct SaveRow
+    {
+        uint32_t guid = 123456;
+        float rating = 1612.375f;
+        float ratingDeviation = 87.5123f;
+        float volatility = 0.0601234f;
+        uint32_t matchesPlayed = 240;
+        uint32_t wins = 131;
+        uint32_t losses = 109;
+        uint32_t lastMatchTime = 1760000000;
+    };
+
+#ifdef GLICKO2_BENCHMARK_FMT
+    void BM_StatementFormat(benchmark::State& state)
+    {
+        SaveRow row;
+        std::string sql =
+            "REPLACE INTO character_battleground_rating "
+            "(guid, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) "
+            "VALUES ({}, {}, {}, {}, {}, {}, {}, {})";
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(row);
+            benchmark::DoNotOptimize(fmt::format(fmt::runtime(sql), row.guid, row.rating, row.ratingDeviation,
+                row.volatility, row.matchesPlayed, row.wins, row.losses, row.lastMatchTime));
+        }
+    }
+#endif
+
+    void BM_StatementBuilder(benchmark::State& state)
+    {
+        SaveRow row;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(row);
+
+            Glicko2SqlBuilder stmt(GLICKO2_REP_BG_RATING);
+            stmt.SetData(0, row.guid);
+            stmt.SetData(1, row.rating);
+            stmt.SetData(2, row.ratingDeviation);
+            stmt.SetData(3, row.volatility);
+            stmt.SetData(4, row.matchesPlayed);
+            stmt.SetData(5, row.wins);
+            stmt.SetData(6, row.losses);
+            stmt.SetData(7, row.lastMatchTime);
+            benchmark::DoNotOptimize(stmt.GetSql());
+        }
+    }
+}
+
+#ifdef GLICKO2_BENCHMARK_FMT
+BENCHMARK(BM_StatementFormat);
+#endif
+BENCHMARK(BM_StatementBuilder);
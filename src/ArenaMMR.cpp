@@ -16,6 +16,7 @@
  */
 
 #include "ArenaMMR.h"
+#include "Glicko2RatingPeriod.h"
 #include "Config.h"
 #include "Log.h"
 #include "Player.h"
@@ -57,41 +58,24 @@ void ArenaMMRMgr::UpdatePlayerRating(ObjectGuid playerGuid, ArenaBracket bracket
     if (!_enabled || opponents.empty())
         return;
 
-    // Get player's current rating
-    ArenaRatingData playerData = sArenaRatingStorage->GetRating(playerGuid, bracket);
+    Glicko2Opponent opposingTeam = AverageTeam(opponents, bracket, won ? 1.0f : 0.0f);
 
-    // Calculate average opponent rating
-    float opponentAvgRating = CalculateAverageRating(opponents, bracket);
-    float opponentAvgRD = 0.0f;
-
-    // Calculate average opponent RD
-    for (ObjectGuid opponentGuid : opponents)
+    if (sGlicko2RatingPeriodMgr->IsEnabled())
     {
-        ArenaRatingData opponentData = sArenaRatingStorage->GetRating(opponentGuid, bracket);
-        opponentAvgRD += opponentData.ratingDeviation;
-    }
-    opponentAvgRD /= opponents.size();
-
-    // Update rating using Glicko-2
-    Glicko2Rating playerRating(playerData.rating, playerData.ratingDeviation, playerData.volatility);
-
-    std::vector<Glicko2Opponent> opponents_;
-    opponents_.emplace_back(opponentAvgRating, opponentAvgRD, won ? 1.0f : 0.0f);
+        sGlicko2RatingPeriodMgr->AddResult(playerGuid, GetArenaRatingPool(bracket), opposingTeam);
+        sArenaRatingStorage->Update(playerGuid, bracket, [won](ArenaRatingData& data)
+        {
+            RecordMatchResult(data, won);
+        });
 
-    Glicko2Rating newRating = _glicko.UpdateRating(playerRating, opponents_);
-
-    // Update player data
-    playerData.rating = newRating.rating;
-    playerData.ratingDeviation = newRating.ratingDeviation;
-    playerData.volatility = newRating.volatility;
-    playerData.matchesPlayed++;
-    if (won)
-        playerData.wins++;
-    else
-        playerData.losses++;
+        return;
+    }
 
-    // Save updated rating
-    sArenaRatingStorage->SetRating(playerGuid, bracket, playerData);
+    Glicko2PreparedOpponent preparedTeam = _glicko.PrepareOpponent(opposingTeam);
+    sArenaRatingStorage->Update(playerGuid, bracket, [&](ArenaRatingData& data)
+    {
+        ApplyMatchResult(data, won, preparedTeam);
+    });
 }
 
 void ArenaMMRMgr::UpdateArenaMatch(Battleground* /*bg*/, std::vector<ObjectGuid> const& winnerGuids,
@@ -100,21 +84,108 @@ void ArenaMMRMgr::UpdateArenaMatch(Battleground* /*bg*/, std::vector<ObjectGuid>
     if (!_enabled || winnerGuids.empty() || loserGuids.empty())
         return;
 
-    // Update all winners
-    for (ObjectGuid winnerGuid : winnerGuids)
+    bool ratingPeriod = sGlicko2RatingPeriodMgr->IsEnabled();
+    std::vector<ObjectGuid> players(winnerGuids);
+    players.insert(players.end(), loserGuids.begin(), loserGuids.end());
+
+    Glicko2Opponent losingAverage(0.0f, 0.0f, 1.0f);
+    Glicko2Opponent winningAverage(0.0f, 0.0f, 0.0f);
+
+    // The whole match is one critical section. Both sides are averaged from
+    // pre-match ratings before anyone is updated, so losers are rated against
+    // the winners as they were during the match
+    sArenaRatingStorage->Update(players, bracket, [&](std::span<ArenaRatingData> data)
     {
-        UpdatePlayerRating(winnerGuid, bracket, true, loserGuids);
-    }
+        std::span<ArenaRatingData> winners = data.first(winnerGuids.size());
+        std::span<ArenaRatingData> losers = data.subspan(winnerGuids.size());
+
+        losingAverage = AverageTeam(losers, 1.0f);
+        winningAverage = AverageTeam(winners, 0.0f);
+
+        if (ratingPeriod)
+        {
+            for (ArenaRatingData& winner : winners)
+                RecordMatchResult(winner, true);
+
+            for (ArenaRatingData& loser : losers)
+                RecordMatchResult(loser, false);
 
-    // Update all losers
-    for (ObjectGuid loserGuid : loserGuids)
+            return;
+        }
+
+        Glicko2PreparedOpponent losingTeam = _glicko.PrepareOpponent(losingAverage);
+        Glicko2PreparedOpponent winningTeam = _glicko.PrepareOpponent(winningAverage);
+
+        for (ArenaRatingData& winner : winners)
+            ApplyMatchResult(winner, true, losingTeam);
+
+        for (ArenaRatingData& loser : losers)
+            ApplyMatchResult(loser, false, winningTeam);
+    });
+
+    if (ratingPeriod)
     {
-        UpdatePlayerRating(loserGuid, bracket, false, winnerGuids);
+        Glicko2RatingPool pool = GetArenaRatingPool(bracket);
+
+        for (ObjectGuid winnerGuid : winnerGuids)
+            sGlicko2RatingPeriodMgr->AddResult(winnerGuid, pool, losingAverage);
+
+        for (ObjectGuid loserGuid : loserGuids)
+            sGlicko2RatingPeriodMgr->AddResult(loserGuid, pool, winningAverage);
+
+        LOG_DEBUG("module", "ArenaMMRMgr: Recorded arena match for the rating period (bracket {})", GetBracketName(bracket));
+        return;
     }
 
     LOG_DEBUG("module", "ArenaMMRMgr: Updated ratings for arena match (bracket {})", GetBracketName(bracket));
 }
 
+Glicko2Opponent ArenaMMRMgr::AverageTeam(std::vector<ObjectGuid> const& playerGuids, ArenaBracket bracket,
+                                         float score) const
+{
+    Glicko2RatingSum sum = sArenaRatingStorage->SumMatchmakingRatings(playerGuids, bracket);
+    return Glicko2Opponent(sum.GetAverageRating(_initialRating), sum.GetAverageRatingDeviation(_initialRD), score);
+}
+
+Glicko2Opponent ArenaMMRMgr::AverageTeam(std::span<ArenaRatingData const> team, float score)
+{
+    float totalRating = 0.0f;
+    float totalRD = 0.0f;
+
+    for (ArenaRatingData const& data : team)
+    {
+        totalRating += data.rating;
+        totalRD += data.ratingDeviation;
+    }
+
+    float count = static_cast<float>(team.size());
+    return Glicko2Opponent(totalRating / count, totalRD / count, score);
+}
+
+void ArenaMMRMgr::ApplyMatchResult(ArenaRatingData& data, bool won, Glicko2PreparedOpponent const& opposingTeam)
+{
+    // Update rating using Glicko-2
+    Glicko2Rating playerRating(data.rating, data.ratingDeviation, data.volatility);
+    std::span<const Glicko2PreparedOpponent> opponents(&opposingTeam, 1);
+    Glicko2Rating newRating = _useDefaultSystem ? _defaultGlicko.UpdateRating(playerRating, opponents)
+                                                : _glicko.UpdateRating(playerRating, opponents);
+
+    data.rating = newRating.rating;
+    data.ratingDeviation = newRating.ratingDeviation;
+    data.volatility = newRating.volatility;
+    RecordMatchResult(data, won);
+}
+
+void ArenaMMRMgr::RecordMatchResult(ArenaRatingData& data, bool won)
+{
+    data.matchesPlayed++;
+    data.lastMatchTime = static_cast<uint32>(time(nullptr));
+    if (won)
+        data.wins++;
+    else
+        data.losses++;
+}
+
 float ArenaMMRMgr::GetPlayerRating(ObjectGuid playerGuid, ArenaBracket bracket) const
 {
     ArenaRatingData data = sArenaRatingStorage->GetRating(playerGuid, bracket);
@@ -129,17 +200,7 @@ float ArenaMMRMgr::GetPlayerRatingDeviation(ObjectGuid playerGuid, ArenaBracket
 
 float ArenaMMRMgr::CalculateAverageRating(std::vector<ObjectGuid> const& playerGuids, ArenaBracket bracket) const
 {
-    if (playerGuids.empty())
-        return _initialRating;
-
-    float totalRating = 0.0f;
-    for (ObjectGuid guid : playerGuids)
-    {
-        ArenaRatingData data = sArenaRatingStorage->GetRating(guid, bracket);
-        totalRating += data.rating;
-    }
-
-    return totalRating / playerGuids.size();
+    return sArenaRatingStorage->SumMatchmakingRatings(playerGuids, bracket).GetAverageRating(_initialRating);
 }
 
 float ArenaMMRMgr::GetRelaxedMMRRange(uint32 queueTimeSeconds, ArenaBracket bracket) const
@@ -168,14 +229,43 @@ float ArenaMMRMgr::GetRelaxationRate(ArenaBracket bracket) const
     return _bracketSettings[static_cast<uint8>(bracket)].relaxationRate;
 }
 
-void ArenaMMRMgr::LoadConfig()
+void ArenaMMRMgr::LoadDefaultRating()
 {
-    // Global arena settings
-    _enabled = sConfigMgr->GetOption<bool>("Glicko2.Arena.Enabled", false);
     _initialRating = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialRating", 1500.0f);
     _initialRD = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialRatingDeviation", 350.0f);
     _initialVolatility = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialVolatility", 0.06f);
+    sArenaRatingStorage->SetDefaultRating(_initialRating, _initialRD, _initialVolatility);
+}
+
+void ArenaMMRMgr::LoadRatingOptions()
+{
     _systemTau = sConfigMgr->GetOption<float>("Glicko2.Arena.Tau", 0.5f);
+    _glicko.SetTau(_systemTau);
+    _useDefaultSystem = _systemTau == Glicko2DefaultSystem::GetTau();
+
+    _solverOptions.mode = sConfigMgr->GetOption<uint32>("Glicko2.Solver.Mode", 0) ?
+        Glicko2SolverMode::WarmStart : Glicko2SolverMode::Reference;
+    _solverOptions.maxIterations = sConfigMgr->GetOption<uint32>("Glicko2.Solver.MaxIterations", 12);
+    _glicko.SetSolverOptions(_solverOptions);
+    _defaultGlicko.SetSolverOptions(_solverOptions);
+
+    _maxWinProbability = sConfigMgr->GetOption<float>("Glicko2.Arena.Matchmaking.MaxWinProbability", 1.0f);
+
+    sArenaRatingStorage->SetInactivityDecay(
+        sConfigMgr->GetOption<uint32>("Glicko2.Arena.InactivityDecay.PeriodSeconds", 604800),
+        sConfigMgr->GetOption<float>("Glicko2.Arena.InactivityDecay.MaxRatingDeviation", 350.0f));
+}
+
+void ArenaMMRMgr::LoadConfig()
+{
+    // Global arena settings
+    _enabled = sConfigMgr->GetOption<bool>("Glicko2.Arena.Enabled", false);
+    LoadDefaultRating();
+    LoadRatingOptions();
+
+    sArenaRatingStorage->SetSaveBatchSize(sConfigMgr->GetOption<uint32>("Glicko2.Save.BatchSize", 500));
+    sArenaRatingStorage->SetShardCount(sConfigMgr->GetOption<uint32>("Glicko2.Cache.Shards", 16));
+    sArenaRatingStorage->SetMemoryBudget(size_t(sConfigMgr->GetOption<uint32>("Glicko2.Cache.MaxMemoryMB", 64)) * 1024 * 1024);
 
     // 2v2 settings
     _bracketSettings[static_cast<uint8>(ArenaBracket::SLOT_2v2)].initialRange =
@@ -19,8 +19,10 @@
 #define ARENA_MMR_H
 
 #include "Glicko2.h"
+#include "Glicko2Static.h"
 #include "ArenaRatingStorage.h"
 #include "ObjectGuid.h"
+#include <span>
 #include <vector>
 
 class Player;
@@ -61,15 +63,25 @@ public:
     float GetInitialRatingDeviation() const { return _initialRD; }
     float GetInitialVolatility() const { return _initialVolatility; }
     float GetSystemTau() const { return _systemTau; }
+    Glicko2SolverOptions const& GetSolverOptions() const { return _solverOptions; }
 
     /// Per-bracket matchmaking settings
     float GetInitialRange(ArenaBracket bracket) const;
     float GetMaxRange(ArenaBracket bracket) const;
     float GetRelaxationRate(ArenaBracket bracket) const;
 
+    /// Largest predicted win probability the queue accepts; 1 disables the gate
+    float GetMaxWinProbability() const { return _maxWinProbability; }
+
     /// Load configuration from worldserver.conf
     void LoadConfig();
 
+    /// Re-read the starting rating and publish it to the storage; safe on config reload
+    void LoadDefaultRating();
+
+    /// Re-read tau, solver, inactivity decay and win probability settings; safe on config reload
+    void LoadRatingOptions();
+
 private:
     ArenaMMRMgr() = default;
     ~ArenaMMRMgr() = default;
@@ -77,12 +89,24 @@ private:
     ArenaMMRMgr(ArenaMMRMgr const&) = delete;
     ArenaMMRMgr& operator=(ArenaMMRMgr const&) = delete;
 
+    /// Average a team's rating and RD into a single opponent
+    Glicko2Opponent AverageTeam(std::vector<ObjectGuid> const& playerGuids, ArenaBracket bracket,
+                                float score) const;
+    static Glicko2Opponent AverageTeam(std::span<ArenaRatingData const> team, float score);
+
+    /// Apply a single result against a prepared opposing team
+    void ApplyMatchResult(ArenaRatingData& data, bool won, Glicko2PreparedOpponent const& opposingTeam);
+
+    /// Count the result now; the rating change is deferred to the end of the rating period
+    static void RecordMatchResult(ArenaRatingData& data, bool won);
+
     /// Global arena settings
     bool _enabled = true;
     float _initialRating = 1500.0f;
     float _initialRD = 350.0f;
     float _initialVolatility = 0.06f;
     float _systemTau = 0.5f;
+    Glicko2SolverOptions _solverOptions;
 
     /// Per-bracket matchmaking ranges
     struct BracketSettings
@@ -93,9 +117,14 @@ private:
     };
 
     BracketSettings _bracketSettings[static_cast<uint8>(ArenaBracket::MAX_SLOTS)];
+    float _maxWinProbability = 1.0f;
 
     /// Glicko-2 calculation system
     Glicko2System _glicko;
+
+    /// Compile-time specialized system, used while the configured tau matches it
+    Glicko2DefaultSystem _defaultGlicko;
+    bool _useDefaultSystem = true;
 };
 
 #define sArenaMMRMgr ArenaMMRMgr::instance()
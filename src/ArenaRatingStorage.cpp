@@ -17,9 +17,23 @@
 
 #include "ArenaRatingStorage.h"
 #include "DatabaseEnv.h"
+#include "Glicko2Statements.h"
 #include "Log.h"
 #include "Player.h"
-#include "Config.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+ArenaRatingStorage::ArenaRatingStorage()
+{
+    // Built-in starting values until LoadConfig() publishes the configured ones
+    ArenaRatingData data;
+    SetDefaultRating(data.rating, data.ratingDeviation, data.volatility);
+}
 
 ArenaRatingStorage* ArenaRatingStorage::instance()
 {
@@ -29,92 +43,195 @@ ArenaRatingStorage* ArenaRatingStorage::instance()
 
 ArenaRatingData ArenaRatingStorage::GetRating(ObjectGuid playerGuid, ArenaBracket bracket)
 {
-    std::shared_lock lock(_mutex);
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+    return ReadEntry(shard, playerGuid, bracket);
+}
 
-    RatingKey key{playerGuid, bracket};
-    auto itr = _ratings.find(key);
-    if (itr != _ratings.end())
+ArenaRatingData ArenaRatingStorage::ReadEntry(RatingCache::Shard const& shard, ObjectGuid playerGuid, ArenaBracket bracket) const
+{
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    RatingCache::RecordLookup(shard, itr != shard.map.end() && itr->second.Has(bracket));
+    if (itr != shard.map.end())
     {
-        return itr->second;
+        RatingCache::Touch(shard, itr->second.lastAccess);
+        if (itr->second.Has(bracket))
+            return ApplyInactivityDecay(itr->second.brackets[static_cast<uint8>(bracket)]);
     }
 
     // Return default rating if not found
-    ArenaRatingData data;
+    return GetDefaultRating(bracket);
+}
+
+Glicko2Rating ArenaRatingStorage::GetMatchmakingRating(ObjectGuid playerGuid, ArenaBracket bracket) const
+{
+    return GetMatchmakingRating(playerGuid, bracket, GetReadContext());
+}
+
+Glicko2Rating ArenaRatingStorage::GetMatchmakingRating(ObjectGuid playerGuid, ArenaBracket bracket, ReadContext const& context) const
+{
+    Glicko2RatingSnapshot snapshot;
+    if (!_index.Find(GetIndexKey(playerGuid, bracket), snapshot))
+    {
+        ArenaRatingData const* defaultData = context.defaultRating;
+        return Glicko2Rating(defaultData->rating, defaultData->ratingDeviation, defaultData->volatility);
+    }
+
+    Glicko2Rating rating(snapshot.rating, snapshot.ratingDeviation, snapshot.volatility);
+    rating.ratingDeviation = DecayRatingDeviation(rating, snapshot.lastMatchTime, context);
+    return rating;
+}
+
+void ArenaRatingStorage::GetMatchmakingRatings(std::span<ObjectGuid const> playerGuids, ArenaBracket bracket,
+    std::span<Glicko2Rating> ratings) const
+{
+    ReadContext context = GetReadContext();
+    for (size_t i = 0; i < playerGuids.size() && i < ratings.size(); ++i)
+        ratings[i] = GetMatchmakingRating(playerGuids[i], bracket, context);
+}
+
+ArenaRatingStorage::ReadContext ArenaRatingStorage::GetReadContext() const
+{
+    ReadContext context;
+    context.defaultRating = _defaultRating.load(std::memory_order_acquire);
+    context.decayPeriod = _decayPeriod.load(std::memory_order_relaxed);
+    context.maxRatingDeviation = _decayMaxRatingDeviation.load(std::memory_order_relaxed);
+    context.now = context.decayPeriod ? static_cast<uint32>(time(nullptr)) : 0;
+    return context;
+}
+
+ArenaRatingData ArenaRatingStorage::GetDefaultRating(ArenaBracket bracket) const
+{
+    ArenaRatingData data = *_defaultRating.load(std::memory_order_acquire);
     data.bracket = bracket;
-    data.rating = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialRating", 1500.0f);
-    data.ratingDeviation = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialRatingDeviation", 350.0f);
-    data.volatility = sConfigMgr->GetOption<float>("Glicko2.Arena.InitialVolatility", 0.06f);
     return data;
 }
 
+void ArenaRatingStorage::SetDefaultRating(float rating, float ratingDeviation, float volatility)
+{
+    std::lock_guard guard(_defaultRatingLock);
+
+    ArenaRatingData const* current = _defaultRating.load(std::memory_order_relaxed);
+    if (current && current->rating == rating && current->ratingDeviation == ratingDeviation &&
+        current->volatility == volatility)
+        return;
+
+    auto data = std::make_unique<ArenaRatingData>();
+    data->rating = rating;
+    data->ratingDeviation = ratingDeviation;
+    data->volatility = volatility;
+
+    _defaultRatings.push_back(std::move(data));
+    _defaultRating.store(_defaultRatings.back().get(), std::memory_order_release);
+}
+
 void ArenaRatingStorage::SetRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data)
 {
-    std::unique_lock lock(_mutex);
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+    WriteEntry(shard, playerGuid, bracket, data);
+}
+
+void ArenaRatingStorage::WriteEntry(RatingCache::Shard& shard, ObjectGuid playerGuid, ArenaBracket bracket,
+    ArenaRatingData const& data)
+{
+    if (!shard.map.contains(playerGuid.GetCounter()))
+        EvictIfFull(shard);
+
+    PlayerRatings& ratings = shard.map[playerGuid.GetCounter()];
+    ArenaRatingData& stored = ratings.brackets[static_cast<uint8>(bracket)];
+    stored = data;
+    stored.bracket = bracket;
+    ratings.present |= PlayerRatings::GetMask(bracket);
+    RatingCache::Touch(shard, ratings.lastAccess);
+
+    // After the login load a bracket without a row starts from the defaults, which are the player's rating
+    if (ratings.loaded)
+        stored.loaded = true;
+
+    // Only loaded data is ever written, so defaults do not pin the record
+    if (stored.loaded)
+    {
+        ++ratings.version;
+        ratings.dirty |= PlayerRatings::GetMask(bracket);
+    }
 
-    RatingKey key{playerGuid, bracket};
-    _ratings[key] = data;
+    PublishRating(playerGuid, bracket, stored);
 }
 
 bool ArenaRatingStorage::HasRating(ObjectGuid playerGuid, ArenaBracket bracket)
 {
-    std::shared_lock lock(_mutex);
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
 
-    RatingKey key{playerGuid, bracket};
-    return _ratings.find(key) != _ratings.end();
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    return itr != shard.map.end() && itr->second.Has(bracket);
 }
 
 void ArenaRatingStorage::RemoveRating(ObjectGuid playerGuid, ArenaBracket bracket)
 {
-    std::unique_lock lock(_mutex);
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
 
-    RatingKey key{playerGuid, bracket};
-    _ratings.erase(key);
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr == shard.map.end() || !itr->second.Has(bracket))
+        return;
+
+    itr->second.brackets[static_cast<uint8>(bracket)] = ArenaRatingData();
+    itr->second.present &= ~PlayerRatings::GetMask(bracket);
+    itr->second.dirty &= ~PlayerRatings::GetMask(bracket);
+    if (!itr->second.dirty)
+        itr->second.savedVersion = itr->second.version;  // Nothing left to write
+
+    _index.Remove(GetIndexKey(playerGuid, bracket));
+
+    if (itr->second.present)
+        return;
+
+    // A login load still in flight must not bring the record back
+    shard.map.erase(playerGuid.GetCounter());
+
+    std::lock_guard pendingGuard(_pendingLock);
+    _pending.erase(playerGuid);
 }
 
 void ArenaRatingStorage::RemoveAllRatings(ObjectGuid playerGuid)
 {
-    std::unique_lock lock(_mutex);
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
 
-    for (uint8 i = 0; i < static_cast<uint8>(ArenaBracket::MAX_SLOTS); ++i)
     {
-        RatingKey key{playerGuid, static_cast<ArenaBracket>(i)};
-        _ratings.erase(key);
+        std::lock_guard pendingGuard(_pendingLock);
+        _pending.erase(playerGuid);
     }
+
+    if (!shard.map.erase(playerGuid.GetCounter()))
+        return;
+
+    for (uint8 i = 0; i < MAX_BRACKETS; ++i)
+        _index.Remove(GetIndexKey(playerGuid, static_cast<ArenaBracket>(i)));
 }
 
 void ArenaRatingStorage::LoadRating(ObjectGuid playerGuid, ArenaBracket bracket)
 {
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT rating, rating_deviation, volatility, matches_played, matches_won, matches_lost "
-        "FROM character_arena_stats WHERE guid = {} AND slot = {}",
-        playerGuid.GetCounter(), static_cast<uint8>(bracket));
+    Glicko2SqlBuilder stmt(GLICKO2_SEL_ARENA_RATING);
+    stmt.SetData(0, playerGuid.GetCounter());
+    stmt.SetData(1, static_cast<uint8>(bracket));
+    QueryResult result = CharacterDatabase.Query(stmt.GetSql());
 
     if (!result)
     {
         return; // No rating found, will use defaults
     }
 
-    Field* fields = result->Fetch();
-
-    ArenaRatingData data;
-    data.rating = fields[0].Get<float>();
-    data.ratingDeviation = fields[1].Get<float>();
-    data.volatility = fields[2].Get<float>();
-    data.matchesPlayed = fields[3].Get<uint32>();
-    data.wins = fields[4].Get<uint32>();
-    data.losses = fields[5].Get<uint32>();
-    data.bracket = bracket;
-    data.loaded = true;
-
-    SetRating(playerGuid, bracket, data);
+    SetRating(playerGuid, bracket, ReadRating(result->Fetch(), bracket));
 }
 
 void ArenaRatingStorage::LoadAllRatings(ObjectGuid playerGuid)
 {
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost "
-        "FROM character_arena_stats WHERE guid = {}",
-        playerGuid.GetCounter());
+    Glicko2SqlBuilder stmt(GLICKO2_SEL_ARENA_RATINGS);
+    stmt.SetData(0, playerGuid.GetCounter());
+    QueryResult result = CharacterDatabase.Query(stmt.GetSql());
 
     if (!result)
     {
@@ -134,111 +251,484 @@ void ArenaRatingStorage::LoadAllRatings(ObjectGuid playerGuid)
         }
 
         ArenaBracket bracket = static_cast<ArenaBracket>(slotId);
+        SetRating(playerGuid, bracket, ReadRating(fields + 1, bracket));
+
+    } while (result->NextRow());
+}
+
+bool ArenaRatingStorage::BeginLoad(ObjectGuid playerGuid)
+{
+    // Records are only evicted clean, so a loaded one kept from an earlier session is current;
+    // one holding only matches rated on the defaults still needs its rows
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr != shard.map.end() && itr->second.loaded)
+        return false;
+
+    std::lock_guard pendingGuard(_pendingLock);
+    return _pending.insert(playerGuid).second;
+}
+
+void ArenaRatingStorage::CompleteLoad(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data)
+{
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    // Removed (character deleted, cache cleared) while the query was in flight
+    {
+        std::lock_guard pendingGuard(_pendingLock);
+        if (!_pending.contains(playerGuid))
+            return;
+    }
+
+    if (!shard.map.contains(playerGuid.GetCounter()))
+        EvictIfFull(shard);
+
+    PlayerRatings& ratings = shard.map[playerGuid.GetCounter()];
+    RatingCache::Touch(shard, ratings.lastAccess);
+
+    ArenaRatingData& current = ratings.brackets[static_cast<uint8>(bracket)];
+    if (ratings.Has(bracket))
+    {
+        // A loaded rating set meanwhile is newer than the row; keep it
+        if (current.loaded)
+            return;
+
+        // Matches finished while the query was in flight were rated on the defaults
+        current = MergeLoadedRow(data, current);
+        if (current != data)
+        {
+            ++ratings.version;  // Not in the DB yet
+            ratings.dirty |= PlayerRatings::GetMask(bracket);
+        }
+    }
+    else
+    {
+        current = data;
+        ratings.present |= PlayerRatings::GetMask(bracket);
+    }
+
+    current.bracket = bracket;
+    PublishRating(playerGuid, bracket, current);
+}
+
+void ArenaRatingStorage::CompleteLoad(ObjectGuid playerGuid)
+{
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    {
+        std::lock_guard pendingGuard(_pendingLock);
+        if (!_pending.erase(playerGuid))
+            return;
+    }
+
+    if (!shard.map.contains(playerGuid.GetCounter()))
+        EvictIfFull(shard);
+
+    PlayerRatings& ratings = shard.map[playerGuid.GetCounter()];
+    RatingCache::Touch(shard, ratings.lastAccess);
+    ratings.loaded = true;
+
+    // Brackets without a row were rated on the defaults, which were the player's rating
+    for (uint8 i = 0; i < MAX_BRACKETS; ++i)
+    {
+        ArenaRatingData& data = ratings.brackets[i];
+        if (!ratings.Has(static_cast<ArenaBracket>(i)) || data.loaded)
+            continue;
 
-        ArenaRatingData data;
-        data.rating = fields[1].Get<float>();
-        data.ratingDeviation = fields[2].Get<float>();
-        data.volatility = fields[3].Get<float>();
-        data.matchesPlayed = fields[4].Get<uint32>();
-        data.wins = fields[5].Get<uint32>();
-        data.losses = fields[6].Get<uint32>();
-        data.bracket = bracket;
         data.loaded = true;
+        ++ratings.version;
+        ratings.dirty |= PlayerRatings::GetMask(static_cast<ArenaBracket>(i));
+    }
+}
 
-        SetRating(playerGuid, bracket, data);
+bool ArenaRatingStorage::IsPending(ObjectGuid playerGuid) const
+{
+    std::lock_guard pendingGuard(_pendingLock);
+    return _pending.contains(playerGuid);
+}
 
-    } while (result->NextRow());
+ArenaRatingData ArenaRatingStorage::MergeLoadedRow(ArenaRatingData row, ArenaRatingData const& playedOnDefaults)
+{
+    // Without earlier matches the defaults were the player's rating, so that result stands
+    if (!row.matchesPlayed)
+    {
+        ArenaRatingData data = playedOnDefaults;
+        data.loaded = true;
+        return data;
+    }
+
+    // Otherwise it was rated from the wrong base: the row wins and only the counts carry over
+    row.matchesPlayed += playedOnDefaults.matchesPlayed;
+    row.wins += playedOnDefaults.wins;
+    row.losses += playedOnDefaults.losses;
+    row.lastMatchTime = std::max(row.lastMatchTime, playedOnDefaults.lastMatchTime);
+    return row;
+}
+
+bool ArenaRatingStorage::PreloadRatings(ObjectGuid playerGuid, std::span<ArenaRatingData const> brackets)
+{
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    // A cached record is at least as new as the rows; a partial one would hide the rest from the next login
+    if (shard.map.contains(playerGuid.GetCounter()))
+        return true;
+
+    if (_ratings.IsFull(shard))
+        return false;
+
+    PlayerRatings& ratings = shard.map[playerGuid.GetCounter()];
+    RatingCache::Touch(shard, ratings.lastAccess);
+    ratings.loaded = true;
+
+    for (ArenaRatingData const& data : brackets)
+    {
+        ratings.brackets[static_cast<uint8>(data.bracket)] = data;
+        ratings.present |= PlayerRatings::GetMask(data.bracket);
+        PublishRating(playerGuid, data.bracket, data);
+    }
+
+    return true;
+}
+
+ArenaRatingData ArenaRatingStorage::ReadRating(Field* fields, ArenaBracket bracket)
+{
+    ArenaRatingData data;
+    data.rating = fields[0].Get<float>();
+    data.ratingDeviation = fields[1].Get<float>();
+    data.volatility = fields[2].Get<float>();
+    data.matchesPlayed = fields[3].Get<uint32>();
+    data.wins = fields[4].Get<uint32>();
+    data.losses = fields[5].Get<uint32>();
+    data.lastMatchTime = fields[6].Get<uint32>();
+    data.bracket = bracket;
+    data.loaded = true;
+    return data;
 }
 
 void ArenaRatingStorage::SaveRating(ObjectGuid playerGuid, ArenaBracket bracket)
 {
-    ArenaRatingData data = GetRating(playerGuid, bracket);
-    SaveRating(playerGuid, bracket, data);
+    // Persist the stored RD; inactivity decay is recomputed from last_match_time on read
+    PlayerRatings ratings;
+    if (!GetPlayerRatings(playerGuid, ratings) || !ratings.Has(bracket))
+        return;
+
+    SaveRating(playerGuid, bracket, ratings.brackets[static_cast<uint8>(bracket)]);
 }
 
 void ArenaRatingStorage::SaveRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data)
+{
+    CharacterDatabase.Execute(MakeSaveStatement(playerGuid, bracket, data).GetSql());
+}
+
+Glicko2SqlBuilder ArenaRatingStorage::MakeSaveStatement(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data)
 {
     // Insert or update arena stats with Glicko-2 data
-    CharacterDatabase.Execute(
-        "INSERT INTO character_arena_stats "
-        "(guid, slot, matchMakerRating, maxMMR, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) "
-        "VALUES ({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, UNIX_TIMESTAMP()) "
-        "ON DUPLICATE KEY UPDATE "
-        "rating = VALUES(rating), "
-        "rating_deviation = VALUES(rating_deviation), "
-        "volatility = VALUES(volatility), "
-        "matches_played = VALUES(matches_played), "
-        "matches_won = VALUES(matches_won), "
-        "matches_lost = VALUES(matches_lost), "
-        "last_match_time = VALUES(last_match_time)",
-        playerGuid.GetCounter(),
-        static_cast<uint8>(bracket),
-        static_cast<uint16>(data.rating),  // matchMakerRating (for compatibility)
-        static_cast<uint16>(data.rating),  // maxMMR (track highest rating)
-        data.rating,
-        data.ratingDeviation,
-        data.volatility,
-        data.matchesPlayed,
-        data.wins,
-        data.losses);
+    Glicko2SqlBuilder stmt(GLICKO2_INS_ARENA_RATING);
+    stmt.SetData(0, playerGuid.GetCounter());
+    stmt.SetData(1, static_cast<uint8>(bracket));
+    stmt.SetData(2, static_cast<uint16>(data.rating));  // matchMakerRating (for compatibility)
+    stmt.SetData(3, static_cast<uint16>(data.rating));  // maxMMR (track highest rating)
+    stmt.SetData(4, data.rating);
+    stmt.SetData(5, data.ratingDeviation);
+    stmt.SetData(6, data.volatility);
+    stmt.SetData(7, data.matchesPlayed);
+    stmt.SetData(8, data.wins);
+    stmt.SetData(9, data.losses);
+    stmt.SetData(10, data.lastMatchTime);
+    return stmt;
 }
 
 void ArenaRatingStorage::SaveAllRatings(ObjectGuid playerGuid)
 {
-    std::shared_lock lock(_mutex);
+    // Copied under the lock, written outside it
+    std::vector<PendingWrite> writes = CollectDirty(playerGuid);
+    for (PendingWrite const& write : writes)
+        SaveRating(playerGuid, write.data.bracket, write.data);
+
+    MarkSaved(writes);
+}
+
+void ArenaRatingStorage::SaveAllRatings(ObjectGuid playerGuid, CharacterDatabaseTransaction trans)
+{
+    std::vector<PendingWrite> writes = CollectDirty(playerGuid);
+    for (PendingWrite const& write : writes)
+        trans->Append(MakeSaveStatement(playerGuid, write.data.bracket, write.data).GetSql().c_str());
+
+    MarkSaved(writes);
+}
+
+std::vector<ArenaRatingStorage::PendingWrite> ArenaRatingStorage::CollectDirty(ObjectGuid playerGuid) const
+{
+    std::vector<PendingWrite> writes;
+
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr != shard.map.end())
+        AppendDirty(playerGuid, itr->second, writes);
+
+    return writes;
+}
 
-    for (uint8 i = 0; i < static_cast<uint8>(ArenaBracket::MAX_SLOTS); ++i)
+void ArenaRatingStorage::AppendDirty(ObjectGuid playerGuid, PlayerRatings const& ratings, std::vector<PendingWrite>& writes)
+{
+    if (!ratings.IsDirty())
+        return;
+
+    for (uint8 i = 0; i < MAX_BRACKETS; ++i)
+        if ((ratings.dirty & (uint8(1) << i)) && ratings.brackets[i].loaded)
+            writes.push_back({ playerGuid, ratings.brackets[i], ratings.version });
+}
+
+void ArenaRatingStorage::MarkSaved(std::span<PendingWrite const> writes)
+{
+    // A player's brackets are adjacent, so each record is marked once
+    for (size_t i = 0; i < writes.size(); ++i)
     {
-        ArenaBracket bracket = static_cast<ArenaBracket>(i);
-        RatingKey key{playerGuid, bracket};
+        if (i && writes[i].guid == writes[i - 1].guid)
+            continue;
 
-        auto itr = _ratings.find(key);
-        if (itr != _ratings.end() && itr->second.loaded)
-        {
-            // Unlock during database operation
-            lock.unlock();
-            SaveRating(playerGuid, bracket, itr->second);
-            lock.lock();
-        }
+        RatingCache::Shard& shard = _ratings.GetShard(writes[i].guid.GetCounter());
+        std::unique_lock lock(shard.mutex);
+
+        // Brackets set meanwhile bumped the version and stay dirty
+        auto itr = shard.map.find(writes[i].guid.GetCounter());
+        if (itr == shard.map.end())
+            continue;
+
+        PlayerRatings& ratings = itr->second;
+        ratings.savedVersion = std::max(ratings.savedVersion, writes[i].version);
+        if (!ratings.IsDirty())
+            ratings.dirty = 0;
     }
 }
 
-void ArenaRatingStorage::SaveAll()
+bool ArenaRatingStorage::GetPlayerRatings(ObjectGuid playerGuid, PlayerRatings& ratings) const
 {
-    std::shared_lock lock(_mutex);
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr == shard.map.end())
+        return false;
 
-    LOG_INFO("module", "ArenaRatingStorage: Saving all arena ratings to database...");
+    ratings = itr->second;
+    return true;
+}
 
-    // Collect all unique player GUIDs
-    std::unordered_set<ObjectGuid> playerGuids;
-    for (auto const& [key, data] : _ratings)
+void ArenaRatingStorage::SaveAll()
+{
+    std::vector<PendingWrite> writes;
+    size_t cached = 0;
+    size_t batchSize = std::max<uint32>(_saveBatchSize, 1);
+
+    // Copy the changed brackets out under every shard lock at once, so a
+    // match committed by a batch Update() is saved whole or not at all;
+    // the DB work runs from the copy after the locks are released
     {
-        if (data.loaded)
+        auto locks = _ratings.LockAllShared();
+        _ratings.ForEachShard([&writes, &cached](RatingCache::Shard const& shard)
         {
-            playerGuids.insert(key.guid);
-        }
+            cached += shard.map.size();
+            for (auto const& [counter, ratings] : shard.map)
+                AppendDirty(ObjectGuid::Create<HighGuid::Player>(counter), ratings, writes);
+        });
     }
 
-    lock.unlock();
+    LOG_INFO("module", "ArenaRatingStorage: Saving {} changed arena ratings of {} cached players...", writes.size(), cached);
 
-    // Save all ratings for each player
-    for (ObjectGuid guid : playerGuids)
+    // One transaction, one multi-row upsert per batch
+    if (!writes.empty())
     {
-        SaveAllRatings(guid);
+        std::span<PendingWrite const> pending(writes);
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+        for (size_t offset = 0; offset < pending.size(); offset += batchSize)
+            AppendBatch(trans, pending.subspan(offset, std::min(batchSize, pending.size() - offset)));
+
+        CharacterDatabase.CommitTransaction(trans);
+        MarkSaved(writes);
     }
 
-    LOG_INFO("module", "ArenaRatingStorage: Saved arena ratings for {} players", playerGuids.size());
+    LOG_INFO("module", "ArenaRatingStorage: Saved {} arena ratings", writes.size());
+}
+
+void ArenaRatingStorage::AppendBatch(CharacterDatabaseTransaction trans, std::span<PendingWrite const> writes)
+{
+    std::string sql =
+        "INSERT INTO character_arena_stats "
+        "(guid, slot, matchMakerRating, maxMMR, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) VALUES ";
+
+    size_t rows = 0;
+    for (PendingWrite const& write : writes)
+    {
+        // "nan" or "inf" would fail the whole transaction, and with it every other rating
+        ArenaRatingData const& data = write.data;
+        if (!std::isfinite(data.rating) || !std::isfinite(data.ratingDeviation) || !std::isfinite(data.volatility))
+        {
+            LOG_ERROR("module", "ArenaRatingStorage: Not saving {} rating of player {}: rating={}, RD={}, vol={}",
+                GetBracketName(data.bracket), write.guid.ToString(), data.rating, data.ratingDeviation, data.volatility);
+            continue;
+        }
+
+        fmt::format_to(std::back_inserter(sql), "{}({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})", rows++ ? ", " : "",
+            write.guid.GetCounter(),
+            static_cast<uint8>(data.bracket),
+            static_cast<uint16>(data.rating),  // matchMakerRating (for compatibility)
+            static_cast<uint16>(data.rating),  // maxMMR (track highest rating)
+            data.rating,
+            data.ratingDeviation,
+            data.volatility,
+            data.matchesPlayed,
+            data.wins,
+            data.losses,
+            data.lastMatchTime);
+    }
+
+    if (!rows)
+        return;
+
+    sql += GLICKO2_RATING_UPSERT_UPDATE;
+    trans->Append(sql.c_str());
 }
 
 void ArenaRatingStorage::ClearCache()
 {
-    std::unique_lock lock(_mutex);
-    _ratings.clear();
+    _ratings.Clear();
+    _index.Clear();
+
+    {
+        std::lock_guard pendingGuard(_pendingLock);
+        _pending.clear();
+    }
+
     LOG_INFO("module", "ArenaRatingStorage: Cache cleared");
 }
 
 size_t ArenaRatingStorage::GetCacheSize() const
 {
-    std::shared_lock lock(_mutex);
-    return _ratings.size();
+    // Counts cached brackets, not players
+    size_t size = 0;
+    _ratings.ForEachShard([&size](RatingCache::Shard const& shard)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (auto const& [counter, ratings] : shard.map)
+            size += std::popcount(ratings.present);
+    });
+
+    return size;
+}
+
+size_t ArenaRatingStorage::GetDirtyCount() const
+{
+    // Counts dirty brackets, not players
+    size_t dirty = 0;
+    _ratings.ForEachShard([&dirty](RatingCache::Shard const& shard)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (auto const& [counter, ratings] : shard.map)
+            dirty += std::popcount(ratings.dirty);
+    });
+
+    return dirty;
+}
+
+void ArenaRatingStorage::SetSaveBatchSize(uint32 rows)
+{
+    _saveBatchSize = rows;
+}
+
+void ArenaRatingStorage::SetShardCount(uint32 shards)
+{
+    _ratings.Resize(shards);
+    _index.Resize(shards);
+}
+
+void ArenaRatingStorage::SetMemoryBudget(size_t bytes)
+{
+    // Worst case right after a table doubles, with every bracket of the record indexed
+    constexpr size_t bytesPerEntry = 2 * (sizeof(RatingCache::Map::value_type) + MAX_BRACKETS * Glicko2RatingIndex::GetSlotSize());
+    _ratings.SetCapacity(bytes ? std::max<size_t>(bytes / bytesPerEntry, 1) : 0);
+}
+
+void ArenaRatingStorage::SetOnline(ObjectGuid playerGuid, bool online)
+{
+    std::lock_guard onlineGuard(_onlineLock);
+    if (online)
+        _online.insert(playerGuid.GetCounter());
+    else
+        _online.erase(playerGuid.GetCounter());
+}
+
+void ArenaRatingStorage::EvictIfFull(RatingCache::Shard& shard)
+{
+    if (!_ratings.IsFull(shard))
+        return;
+
+    std::lock_guard onlineGuard(_onlineLock);
+
+    // Unsaved brackets and logged in players stay; a later login reloads anything evicted
+    size_t evicted = _ratings.Evict(shard,
+        [this](ObjectGuid::LowType counter, PlayerRatings const& ratings)
+        {
+            return !ratings.IsDirty() && !_online.contains(counter);
+        },
+        [this](ObjectGuid::LowType counter, PlayerRatings const& ratings)
+        {
+            ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+            for (uint8 i = 0; i < MAX_BRACKETS; ++i)
+                if (ratings.Has(static_cast<ArenaBracket>(i)))
+                    _index.Remove(GetIndexKey(guid, static_cast<ArenaBracket>(i)));
+        });
+
+    LOG_DEBUG("module", "ArenaRatingStorage: Evicted {} players from a full cache shard ({} left)", evicted, shard.map.size());
+}
+
+void ArenaRatingStorage::SetInactivityDecay(uint32 periodSeconds, float maxRatingDeviation)
+{
+    _decayPeriod = periodSeconds;
+    _decayMaxRatingDeviation = maxRatingDeviation;
+}
+
+ArenaRatingData ArenaRatingStorage::ApplyInactivityDecay(ArenaRatingData const& data) const
+{
+    ArenaRatingData result = data;
+    result.ratingDeviation = DecayRatingDeviation(
+        Glicko2Rating(data.rating, data.ratingDeviation, data.volatility), data.lastMatchTime, GetReadContext());
+    return result;
+}
+
+float ArenaRatingStorage::DecayRatingDeviation(Glicko2Rating const& rating, uint32 lastMatchTime,
+    ReadContext const& context) const
+{
+    if (!context.decayPeriod || !lastMatchTime || context.now <= lastMatchTime)
+        return rating.ratingDeviation;
+
+    uint32 periods = (context.now - lastMatchTime) / context.decayPeriod;
+    if (!periods)
+        return rating.ratingDeviation;
+
+    return _glicko.UpdateInactiveRating(rating, periods, context.maxRatingDeviation).ratingDeviation;
+}
+
+uint64 ArenaRatingStorage::GetIndexKey(ObjectGuid playerGuid, ArenaBracket bracket)
+{
+    // Slot + 1 keeps the key clear of the reserved 0
+    return (static_cast<uint64>(playerGuid.GetCounter()) << 8) | (static_cast<uint8>(bracket) + 1);
+}
+
+void ArenaRatingStorage::PublishRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data)
+{
+    Glicko2RatingSnapshot snapshot;
+    snapshot.rating = data.rating;
+    snapshot.ratingDeviation = data.ratingDeviation;
+    snapshot.volatility = data.volatility;
+    snapshot.lastMatchTime = data.lastMatchTime;
+    _index.Publish(GetIndexKey(playerGuid, bracket), snapshot);
 }
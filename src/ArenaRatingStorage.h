@@ -20,8 +20,18 @@
 
 #include "ObjectGuid.h"
 #include "DatabaseEnvFwd.h"
-#include <unordered_map>
-#include <shared_mutex>
+#include "Glicko2.h"
+#include "Glicko2ShardedCache.h"
+#include "Glicko2RatingIndex.h"
+#include "Glicko2Statements.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <span>
 
 class Player;
 
@@ -44,6 +54,7 @@ struct ArenaRatingData
     uint32 matchesPlayed = 0;           ///< Total matches played in this bracket
     uint32 wins = 0;                    ///< Total wins in this bracket
     uint32 losses = 0;                  ///< Total losses in this bracket
+    uint32 lastMatchTime = 0;           ///< Unix time of the last rated match (0 = never)
     ArenaBracket bracket;               ///< Which bracket this rating is for
     bool loaded = false;                ///< Whether data is loaded from DB
 
@@ -52,6 +63,8 @@ struct ArenaRatingData
     ArenaRatingData(float r, float rd, float v, uint32 mp, uint32 w, uint32 l, ArenaBracket b)
         : rating(r), ratingDeviation(rd), volatility(v),
           matchesPlayed(mp), wins(w), losses(l), bracket(b), loaded(true) { }
+
+    bool operator==(ArenaRatingData const& other) const = default;
 };
 
 /// @brief Thread-safe storage for player arena ratings per bracket
@@ -63,9 +76,80 @@ public:
     /// Get rating for specific bracket
     ArenaRatingData GetRating(ObjectGuid playerGuid, ArenaBracket bracket);
 
+    /// Rating, RD (decayed) and volatility for matchmaking, read without taking a cache lock
+    Glicko2Rating GetMatchmakingRating(ObjectGuid playerGuid, ArenaBracket bracket) const;
+
+    /// GetMatchmakingRating() of every player into ratings[i]; the clock and decay settings are read once
+    void GetMatchmakingRatings(std::span<ObjectGuid const> playerGuids, ArenaBracket bracket, std::span<Glicko2Rating> ratings) const;
+
+    /// Summed matchmaking rating and RD of any range of player GUIDs in one bracket, read without taking a cache lock
+    template <typename Range>
+    Glicko2RatingSum SumMatchmakingRatings(Range const& playerGuids, ArenaBracket bracket) const
+    {
+        ReadContext context = GetReadContext();
+        Glicko2RatingSum sum;
+        for (ObjectGuid playerGuid : playerGuids)
+        {
+            Glicko2Rating rating = GetMatchmakingRating(playerGuid, bracket, context);
+            sum.Add(rating.rating, rating.ratingDeviation);
+        }
+
+        return sum;
+    }
+
     /// Set rating for specific bracket
     void SetRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
 
+    /**
+     * @brief Read-modify-write of one bracket under a single shard lock
+     *
+     * fn(ArenaRatingData&) sees what GetRating() would return and its result
+     * is stored as SetRating() would store it; nothing is written if fn
+     * leaves the data unchanged.
+     */
+    template <typename Function>
+    void Update(ObjectGuid playerGuid, ArenaBracket bracket, Function&& fn)
+    {
+        RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+        std::unique_lock lock(shard.mutex);
+
+        ArenaRatingData const current = ReadEntry(shard, playerGuid, bracket);
+        ArenaRatingData data = current;
+        fn(data);
+
+        if (data != current)
+            WriteEntry(shard, playerGuid, bracket, data);
+    }
+
+    /**
+     * @brief Read-modify-write of one bracket of several players in one critical section
+     *
+     * Every shard involved stays locked from the reads to the writes, so
+     * fn(std::span<ArenaRatingData>) can compute a whole match from
+     * consistent ratings; element i belongs to playerGuids[i].
+     */
+    template <typename Function>
+    void Update(std::span<ObjectGuid const> playerGuids, ArenaBracket bracket, Function&& fn)
+    {
+        std::vector<ObjectGuid::LowType> counters(playerGuids.size());
+        std::transform(playerGuids.begin(), playerGuids.end(), counters.begin(),
+            [](ObjectGuid guid) { return guid.GetCounter(); });
+
+        auto locks = _ratings.LockShards(counters);
+
+        std::vector<ArenaRatingData> current;
+        current.reserve(playerGuids.size());
+        for (ObjectGuid playerGuid : playerGuids)
+            current.push_back(ReadEntry(_ratings.GetShard(playerGuid.GetCounter()), playerGuid, bracket));
+
+        std::vector<ArenaRatingData> data = current;
+        fn(std::span<ArenaRatingData>(data));
+
+        for (size_t i = 0; i < playerGuids.size(); ++i)
+            if (data[i] != current[i])
+                WriteEntry(_ratings.GetShard(counters[i]), playerGuids[i], bracket, data[i]);
+    }
+
     /// Check if player has rating for bracket
     bool HasRating(ObjectGuid playerGuid, ArenaBracket bracket);
 
@@ -81,55 +165,177 @@ public:
     /// Load all brackets for a player from database
     void LoadAllRatings(ObjectGuid playerGuid);
 
+    /// Mark an async login load as started; false while the player's loaded record is cached or a load is in flight
+    bool BeginLoad(ObjectGuid playerGuid);
+
+    /// Cache a bracket fetched by an async login load; matches rated meanwhile are merged in
+    void CompleteLoad(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
+
+    /// Finish a login load; players without arena rows keep an empty record so the next login skips the query
+    void CompleteLoad(ObjectGuid playerGuid);
+
+    /// Whether an async load for the player is still outstanding
+    bool IsPending(ObjectGuid playerGuid) const;
+
+    /// Cache every bracket of a player read by the startup preload, or none; false when the shard is full
+    bool PreloadRatings(ObjectGuid playerGuid, std::span<ArenaRatingData const> brackets);
+
+    /// Rating, RD, volatility, played, won, lost and last match time starting at fields[0]
+    static ArenaRatingData ReadRating(Field* fields, ArenaBracket bracket);
+
     /// Save rating for specific bracket to database
     void SaveRating(ObjectGuid playerGuid, ArenaBracket bracket);
 
     /// Save specific rating data to database
     void SaveRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
 
-    /// Save all brackets for a player to database
+    /// Save the player's changed brackets to database
     void SaveAllRatings(ObjectGuid playerGuid);
+    void SaveAllRatings(ObjectGuid playerGuid, CharacterDatabaseTransaction trans);
 
-    /// Save all cached ratings to database
+    /// Write every changed bracket from one snapshot of all shards; the DB work runs outside the locks
     void SaveAll();
 
+    /// Number of cached bracket ratings with changes not yet written to the DB
+    size_t GetDirtyCount() const;
+
     /// Clear in-memory cache
     void ClearCache();
 
-    /// Get number of cached entries
+    /// Get number of cached bracket ratings
     size_t GetCacheSize() const;
 
+    /// Configure the lazy inactivity decay applied by GetRating() (period 0 disables it)
+    void SetInactivityDecay(uint32 periodSeconds, float maxRatingDeviation);
+
+    /// Rows per multi-row upsert written by SaveAll()
+    void SetSaveBatchSize(uint32 rows);
+
+    /// Replace the rating, RD and volatility given to players without a row; readers switch over atomically
+    void SetDefaultRating(float rating, float ratingDeviation, float volatility);
+
+    /// Number of independently locked cache shards (startup only)
+    void SetShardCount(uint32 shards);
+    size_t GetShardCount() const { return _ratings.GetShardCount(); }
+
+    /// Bound the cache to roughly this many bytes (0 = unbounded); clean offline players are evicted LRU first
+    void SetMemoryBudget(size_t bytes);
+
+    /// Online players are never evicted
+    void SetOnline(ObjectGuid playerGuid, bool online);
+
+    /// Hit, miss and eviction counters of GetRating(); entries count players, not brackets
+    Glicko2CacheStats GetCacheStats() const { return _ratings.GetStats(); }
+
 private:
-    ArenaRatingStorage() = default;
+    ArenaRatingStorage();
     ~ArenaRatingStorage() = default;
 
     ArenaRatingStorage(ArenaRatingStorage const&) = delete;
     ArenaRatingStorage& operator=(ArenaRatingStorage const&) = delete;
 
-    /// Composite key for rating lookups
-    struct RatingKey
+    static constexpr uint8 MAX_BRACKETS = static_cast<uint8>(ArenaBracket::MAX_SLOTS);
+
+    /// @brief Every cached bracket of one player, fetched with a single lookup
+    struct PlayerRatings
     {
-        ObjectGuid guid;
-        ArenaBracket bracket;
+        std::array<ArenaRatingData, MAX_BRACKETS> brackets;
+        uint8 present = 0;              ///< Bit n set while brackets[n] is cached
+        uint8 dirty = 0;                ///< Bit n set while brackets[n] has changes not yet saved
+        uint32 version = 0;             ///< Bumped by every SetRating() of loaded data
+        uint32 savedVersion = 0;        ///< Version last written to (or read from) the DB
+        mutable uint32 lastAccess = 0;  ///< LRU stamp, written by reads under the shared lock
+        bool loaded = false;            ///< Set once a login load or the preload has filled the record
+
+        static uint8 GetMask(ArenaBracket bracket) { return uint8(1) << static_cast<uint8>(bracket); }
+        bool Has(ArenaBracket bracket) const { return present & GetMask(bracket); }
+        bool IsDirty() const { return version != savedVersion; }
+    };
 
-        bool operator==(RatingKey const& other) const
-        {
-            return guid == other.guid && bracket == other.bracket;
-        }
+    /// @brief Entry captured for a flush
+    struct PendingWrite
+    {
+        ObjectGuid guid;
+        ArenaRatingData data;
+        uint32 version;                 ///< Record version the data was copied at
     };
 
-    /// Hash function for RatingKey
-    struct RatingKeyHash
+    /// Copy the player's changed brackets out
+    std::vector<PendingWrite> CollectDirty(ObjectGuid playerGuid) const;
+
+    /// Append the changed brackets of one record; called under its shard lock
+    static void AppendDirty(ObjectGuid playerGuid, PlayerRatings const& ratings, std::vector<PendingWrite>& writes);
+
+    /// Single-row save statement
+    static Glicko2SqlBuilder MakeSaveStatement(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
+
+    /// Append one multi-row upsert covering the given writes
+    static void AppendBatch(CharacterDatabaseTransaction trans, std::span<PendingWrite const> writes);
+
+    /// Row of a login load combined with the matches rated on the defaults while it was in flight
+    static ArenaRatingData MergeLoadedRow(ArenaRatingData row, ArenaRatingData const& playedOnDefaults);
+
+    /// Raise RD for every whole period since lastMatchTime; the stored entry is left untouched
+    ArenaRatingData ApplyInactivityDecay(ArenaRatingData const& data) const;
+
+    /// @brief Default template, clock and decay settings, loaded once per read or batch of reads
+    struct ReadContext
     {
-        size_t operator()(RatingKey const& key) const
-        {
-            return std::hash<uint64>()(key.guid.GetRawValue()) ^
-                   (std::hash<uint8>()(static_cast<uint8>(key.bracket)) << 1);
-        }
+        ArenaRatingData const* defaultRating = nullptr;
+        uint32 now = 0;                     ///< Only read when decayPeriod is set
+        uint32 decayPeriod = 0;
+        float maxRatingDeviation = 0.0f;
     };
 
-    std::unordered_map<RatingKey, ArenaRatingData, RatingKeyHash> _ratings;
-    mutable std::shared_mutex _mutex;
+    ReadContext GetReadContext() const;
+    Glicko2Rating GetMatchmakingRating(ObjectGuid playerGuid, ArenaBracket bracket, ReadContext const& context) const;
+    float DecayRatingDeviation(Glicko2Rating const& rating, uint32 lastMatchTime, ReadContext const& context) const;
+
+    /// Rating given to players without a row in the bracket
+    ArenaRatingData GetDefaultRating(ArenaBracket bracket) const;
+
+    /// Copy of the player's cached brackets; false when none are cached
+    bool GetPlayerRatings(ObjectGuid playerGuid, PlayerRatings& ratings) const;
+
+    /// Read index key: GUID counter in the high bits, slot + 1 in the low byte
+    static uint64 GetIndexKey(ObjectGuid playerGuid, ArenaBracket bracket);
+
+    /// Copy the matchmaking fields into the read index; called under the entry's shard lock
+    void PublishRating(ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
+
+    /// Record that the given versions reached the DB; records changed meanwhile stay dirty
+    void MarkSaved(std::span<PendingWrite const> writes);
+
+    /// Keyed by GUID counter: every cached GUID is a player
+    using RatingCache = Glicko2ShardedCache<ObjectGuid::LowType, PlayerRatings>;
+
+    /// Make room before inserting a new key; called under the shard's unique lock
+    void EvictIfFull(RatingCache::Shard& shard);
+
+    /// GetRating() and SetRating() under a shard lock the caller already holds (unique for WriteEntry)
+    ArenaRatingData ReadEntry(RatingCache::Shard const& shard, ObjectGuid playerGuid, ArenaBracket bracket) const;
+    void WriteEntry(RatingCache::Shard& shard, ObjectGuid playerGuid, ArenaBracket bracket, ArenaRatingData const& data);
+
+    RatingCache _ratings;
+    Glicko2RatingIndex _index;      ///< Matchmaking fields of every cached bracket
+
+    /// Async loads in flight; taken after a shard lock, never before one
+    std::unordered_set<ObjectGuid> _pending;
+    mutable std::mutex _pendingLock;
+
+    /// Players logged in; taken after a shard lock, never before one
+    std::unordered_set<ObjectGuid::LowType> _online;
+    std::mutex _onlineLock;
+
+    /// Current default template; earlier ones stay alive for readers that loaded them
+    std::atomic<ArenaRatingData const*> _defaultRating = nullptr;
+    std::vector<std::unique_ptr<ArenaRatingData const>> _defaultRatings;
+    std::mutex _defaultRatingLock;
+
+    std::atomic<uint32> _saveBatchSize = 500;               ///< Rows per multi-row upsert in SaveAll()
+    std::atomic<uint32> _decayPeriod = 0;                   ///< Inactivity period length in seconds
+    std::atomic<float> _decayMaxRatingDeviation = 350.0f;   ///< RD never decays past this value
+    Glicko2System _glicko;
 };
 
 #define sArenaRatingStorage ArenaRatingStorage::instance()
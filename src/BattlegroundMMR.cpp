@@ -19,6 +19,7 @@
 #include "Glicko2PlayerStorage.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
+#include "Glicko2Statements.h"
 #include "Item.h"
 #include "Log.h"
 
@@ -46,6 +47,12 @@ void BattlegroundMMRMgr::LoadConfig()
 
     _glicko.SetTau(_systemTau);
 
+    sGlicko2Storage->SetSaveBatchSize(sConfigMgr->GetOption<uint32>("Glicko2.Save.BatchSize", 500));
+    sGlicko2Storage->SetShardCount(sConfigMgr->GetOption<uint32>("Glicko2.Cache.Shards", 16));
+    sGlicko2Storage->SetMemoryBudget(size_t(sConfigMgr->GetOption<uint32>("Glicko2.Cache.MaxMemoryMB", 64)) * 1024 * 1024);
+    LoadDefaultRating();
+    LoadRatingOptions();
+
     LOG_INFO("server.loading", ">> BattlegroundMMRMgr: System {} (Tau: {}, Starting Rating: {})",
              _enabled ? "ENABLED" : "DISABLED", _systemTau, _startingRating);
 
@@ -58,6 +65,27 @@ void BattlegroundMMRMgr::LoadConfig()
     }
 }
 
+void BattlegroundMMRMgr::LoadDefaultRating()
+{
+    sGlicko2Storage->SetDefaultRating(
+        sConfigMgr->GetOption<float>("Glicko2.InitialRating", 1500.0f),
+        sConfigMgr->GetOption<float>("Glicko2.InitialRatingDeviation", 350.0f),
+        sConfigMgr->GetOption<float>("Glicko2.InitialVolatility", 0.06f));
+}
+
+void BattlegroundMMRMgr::LoadRatingOptions()
+{
+    _matchTau = sConfigMgr->GetOption<float>("Glicko2.Tau", 0.5f);
+    _solverOptions.mode = sConfigMgr->GetOption<uint32>("Glicko2.Solver.Mode", 0) ?
+        Glicko2SolverMode::WarmStart : Glicko2SolverMode::Reference;
+    _solverOptions.maxIterations = sConfigMgr->GetOption<uint32>("Glicko2.Solver.MaxIterations", 12);
+    _maxWinProbability = sConfigMgr->GetOption<float>("BattleGround.MMR.Matchmaking.MaxWinProbability", 1.0f);
+
+    sGlicko2Storage->SetInactivityDecay(
+        sConfigMgr->GetOption<uint32>("BattleGround.MMR.InactivityDecay.PeriodSeconds", 604800),
+        sConfigMgr->GetOption<float>("BattleGround.MMR.InactivityDecay.MaxRatingDeviation", 350.0f));
+}
+
 float BattlegroundMMRMgr::CalculateGearScore(Player* player)
 {
     if (!player)
@@ -111,12 +139,6 @@ void BattlegroundMMRMgr::UpdatePlayerRating(Player* player, bool won, const std:
         return;
     }
 
-    // Get current rating from external storage
-    BattlegroundRatingData currentRating = sGlicko2Storage->GetRating(player->GetGUID());
-
-    LOG_DEBUG("bg.mmr", "UpdatePlayerRating called for {} - Current rating: {:.2f}, Loaded: {}",
-              player->GetName(), currentRating.rating, currentRating.loaded);
-
     // Build opponent list for Glicko-2
     std::vector<Glicko2Opponent> glickoOpponents;
     glickoOpponents.reserve(opponents.size());
@@ -130,36 +152,42 @@ void BattlegroundMMRMgr::UpdatePlayerRating(Player* player, bool won, const std:
         glickoOpponents.emplace_back(oppRating.rating, oppRating.ratingDeviation, won ? 1.0f : 0.0f);
     }
 
-    float oldRating = currentRating.rating;
-    float oldRD = currentRating.ratingDeviation;
+    float oldRating = 0.0f;
+    float oldRD = 0.0f;
+    BattlegroundRatingData currentRating;
+
+    // Read, rate and write back under one lock (will be saved on logout/periodic save)
+    sGlicko2Storage->Update(player->GetGUID(), [&](BattlegroundRatingData& data)
+    {
+        oldRating = data.rating;
+        oldRD = data.ratingDeviation;
 
-    Glicko2Rating glickoRating(currentRating.rating, currentRating.ratingDeviation, currentRating.volatility);
-    Glicko2Rating newRating = _glicko.UpdateRating(glickoRating, glickoOpponents);
+        Glicko2Rating glickoRating(data.rating, data.ratingDeviation, data.volatility);
+        Glicko2Rating newRating = _glicko.UpdateRating(glickoRating, glickoOpponents);
 
-    currentRating.rating = newRating.rating;
-    currentRating.ratingDeviation = newRating.ratingDeviation;
-    currentRating.volatility = newRating.volatility;
-    currentRating.matchesPlayed++;
+        data.rating = newRating.rating;
+        data.ratingDeviation = newRating.ratingDeviation;
+        data.volatility = newRating.volatility;
+        data.matchesPlayed++;
+        data.lastMatchTime = static_cast<uint32>(time(nullptr));
 
-    if (won)
-        currentRating.wins++;
-    else
-        currentRating.losses++;
+        if (won)
+            data.wins++;
+        else
+            data.losses++;
 
-    // Update external storage (will be saved on logout/periodic save)
-    sGlicko2Storage->SetRating(player->GetGUID(), currentRating);
+        currentRating = data;
+    });
 
     // Log to history table (async)
-    CharacterDatabase.Execute(
-        "INSERT INTO character_battleground_rating_history "
-        "(guid, rating, rating_deviation, volatility, match_time, match_result) "
-        "VALUES ({}, {}, {}, {}, {}, {})",
-        player->GetGUID().GetCounter(),
-        currentRating.rating,
-        currentRating.ratingDeviation,
-        currentRating.volatility,
-        static_cast<uint32>(time(nullptr)),
-        won ? 1 : 0);
+    Glicko2SqlBuilder stmt(GLICKO2_INS_BG_RATING_HISTORY);
+    stmt.SetData(0, player->GetGUID().GetCounter());
+    stmt.SetData(1, currentRating.rating);
+    stmt.SetData(2, currentRating.ratingDeviation);
+    stmt.SetData(3, currentRating.volatility);
+    stmt.SetData(4, static_cast<uint32>(time(nullptr)));
+    stmt.SetData(5, uint8(won ? 1 : 0));
+    CharacterDatabase.Execute(stmt.GetSql());
 
     LOG_DEBUG("bg.mmr", "Player {} rating updated: {} -> {} (RD: {} -> {}, Result: {})",
               player->GetName(), oldRating, currentRating.rating, oldRD, currentRating.ratingDeviation,
@@ -50,8 +50,21 @@ public:
     float GetRelaxedMMRTolerance(uint32 queueTimeSeconds) const;
     float GetInitialMaxMMRDifference() const { return _initialMaxMMRDifference; }
 
+    /// Largest predicted win probability the queue accepts; 1 disables the gate
+    float GetMaxWinProbability() const { return _maxWinProbability; }
+
+    /// Tau and volatility solver settings for BG match updates (Glicko2.Tau, Glicko2.Solver.*)
+    float GetMatchTau() const { return _matchTau; }
+    Glicko2SolverOptions const& GetSolverOptions() const { return _solverOptions; }
+
     void LoadConfig();
 
+    /// Publish the Glicko2.Initial* starting rating to the storage; safe on config reload
+    void LoadDefaultRating();
+
+    /// Read the per-match tau, solver, inactivity decay and win probability settings; safe on config reload
+    void LoadRatingOptions();
+
 private:
     bool _enabled;
     float _startingRating;
@@ -66,6 +79,10 @@ private:
     uint32 _relaxationIntervalSeconds;
     float _relaxationStepMMR;
     uint32 _maxRelaxationSeconds;
+    float _maxWinProbability = 1.0f;
+
+    float _matchTau = 0.5f;
+    Glicko2SolverOptions _solverOptions;
 
     Glicko2System _glicko;
 };
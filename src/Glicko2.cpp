@@ -33,6 +33,16 @@
  */
 
 #include "Glicko2.h"
+#include "Glicko2Simd.h"
+#include <type_traits>
+
+// UpdateRating() hands Glicko2Opponent arrays to the SIMD kernel as strided floats
+static_assert(std::is_standard_layout_v<Glicko2Opponent> && sizeof(Glicko2Opponent) == 3 * sizeof(float),
+              "Glicko2Opponent must stay three packed floats");
+
+// ExpectedScore()/WinProbability() hand Glicko2Rating arrays to the SIMD kernel the same way
+static_assert(std::is_standard_layout_v<Glicko2Rating> && sizeof(Glicko2Rating) == 3 * sizeof(float),
+              "Glicko2Rating must stay three packed floats");
 
 float Glicko2System::ConvertRatingToGlicko2(float rating) const
 {
@@ -59,43 +69,35 @@ float Glicko2System::CalculateG(float phi) const
     return 1.0f / std::sqrt(1.0f + (3.0f * phi * phi) / PI_SQUARED);
 }
 
-float Glicko2System::CalculateE(float mu, float muJ, float phiJ) const
+float Glicko2System::CalculateE(float mu, float muJ, float gPhiJ) const
 {
-    return 1.0f / (1.0f + std::exp(-CalculateG(phiJ) * (mu - muJ)));
+    return 1.0f / (1.0f + std::exp(-gPhiJ * (mu - muJ)));
 }
 
-float Glicko2System::CalculateVariance(float mu, const std::vector<Glicko2Opponent>& opponents) const
+void Glicko2System::AccumulateOpponent(OpponentSums& sums, float mu, float rating, float rd, float score) const
 {
-    float sum = 0.0f;
-
-    for (auto const& opponent : opponents)
-    {
-        float muJ = ConvertRatingToGlicko2(opponent.rating);
-        float phiJ = ConvertRDToGlicko2(opponent.ratingDeviation);
-        float gPhiJ = CalculateG(phiJ);
-        float e = CalculateE(mu, muJ, phiJ);
-
-        sum += gPhiJ * gPhiJ * e * (1.0f - e);
-    }
+    float muJ = ConvertRatingToGlicko2(rating);
+    float phiJ = ConvertRDToGlicko2(rd);
+    float gPhiJ = CalculateG(phiJ);
+    float e = CalculateE(mu, muJ, gPhiJ);
 
-    return sum > 0.0f ? 1.0f / sum : 0.0f;
+    sums.varianceSum += gPhiJ * gPhiJ * e * (1.0f - e);
+    sums.deltaSum += gPhiJ * (score - e);
 }
 
-float Glicko2System::CalculateDelta(float mu, float variance, const std::vector<Glicko2Opponent>& opponents) const
+Glicko2System::OpponentSums Glicko2System::AccumulateOpponents(float mu, const float* ratings, const float* rds,
+                                                               const float* scores, std::size_t stride,
+                                                               std::size_t count) const
 {
-    float sum = 0.0f;
+    OpponentSums sums{ 0.0f, 0.0f };
 
-    for (auto const& opponent : opponents)
-    {
-        float muJ = ConvertRatingToGlicko2(opponent.rating);
-        float phiJ = ConvertRDToGlicko2(opponent.ratingDeviation);
-        float gPhiJ = CalculateG(phiJ);
-        float e = CalculateE(mu, muJ, phiJ);
+    std::size_t done = Glicko2Simd::AccumulateBlocks(mu, ratings, rds, scores, stride, count,
+                                                     sums.varianceSum, sums.deltaSum);
 
-        sum += gPhiJ * (opponent.score - e);
-    }
+    for (std::size_t j = done; j < count; ++j)
+        AccumulateOpponent(sums, mu, ratings[j * stride], rds[j * stride], scores[j * stride]);
 
-    return variance * sum;
+    return sums;
 }
 
 float Glicko2System::VolatilityFunction(float x, float delta, float phi, float variance, float a) const
@@ -113,80 +115,118 @@ float Glicko2System::VolatilityFunction(float x, float delta, float phi, float v
 
 float Glicko2System::IllinoisAlgorithm(float a, float delta, float phi, float variance, float /*sigma*/) const
 {
-    // Step 1: Initialize
-    float A = a;
-    float B;
+    return Glicko2Solver::SolveVolatility(a, delta * delta, phi * phi, variance, _tau, _epsilon, _solverOptions,
+        [&](float x) { return VolatilityFunction(x, delta, phi, variance, a); });
+}
 
-    float deltaSquared = delta * delta;
-    float phiSquared = phi * phi;
+float Glicko2System::UpdateVolatility(float phi, float variance, float delta, float sigma) const
+{
+    float a = std::log(sigma * sigma);
+    return IllinoisAlgorithm(a, delta, phi, variance, sigma);
+}
 
-    // Step 2: Set initial values for bracketing
-    if (deltaSquared > phiSquared + variance)
-    {
-        B = std::log(deltaSquared - phiSquared - variance);
-    }
-    else
+Glicko2Rating Glicko2System::UpdateRating(const Glicko2Rating& playerRating,
+                                          const std::vector<Glicko2Opponent>& opponents)
+{
+    // Handle edge case: no opponents
+    if (opponents.empty())
+        return UpdateInactiveRating(playerRating);
+
+    // Steps 3, 4 and 7 share g(φj) and E, so evaluate them in a single pass
+    float mu = ConvertRatingToGlicko2(playerRating.rating);
+    const Glicko2Opponent& first = opponents.front();
+    OpponentSums sums = AccumulateOpponents(mu, &first.rating, &first.ratingDeviation, &first.score,
+                                            3, opponents.size());
+
+    return ApplyOpponentSums(playerRating, sums);
+}
+
+Glicko2Rating Glicko2System::UpdateRating(const Glicko2Rating& playerRating,
+                                          std::span<const Glicko2PreparedOpponent> opponents)
+{
+    if (opponents.empty())
+        return UpdateInactiveRating(playerRating);
+
+    float mu = ConvertRatingToGlicko2(playerRating.rating);
+
+    // g(φj) is already known, only E needs evaluating per opponent
+    OpponentSums sums{ 0.0f, 0.0f };
+    for (auto const& opponent : opponents)
     {
-        // Find B by iteration
-        int k = 1;
-        while (VolatilityFunction(a - k * _tau, delta, phi, variance, a) < 0.0f)
-        {
-            k++;
-            if (k > 100) // Safety limit
-                break;
-        }
-        B = a - k * _tau;
+        float e = CalculateE(mu, opponent.mu, opponent.gPhi);
+
+        sums.varianceSum += opponent.gPhi * opponent.gPhi * e * (1.0f - e);
+        sums.deltaSum += opponent.gPhi * (opponent.score - e);
     }
 
-    float fA = VolatilityFunction(A, delta, phi, variance, a);
-    float fB = VolatilityFunction(B, delta, phi, variance, a);
+    return ApplyOpponentSums(playerRating, sums);
+}
+
+Glicko2PreparedOpponent Glicko2System::PrepareOpponent(const Glicko2Opponent& opponent) const
+{
+    Glicko2PreparedOpponent prepared;
+    prepared.mu = ConvertRatingToGlicko2(opponent.rating);
+    prepared.phi = ConvertRDToGlicko2(opponent.ratingDeviation);
+    prepared.gPhi = CalculateG(prepared.phi);
+    prepared.score = opponent.score;
+    return prepared;
+}
 
-    // Step 3: Illinois algorithm iteration
-    while (std::abs(B - A) > _epsilon)
+void Glicko2System::UpdateRatingsBatch(Glicko2RatingBatch players, Glicko2OpponentBatch const& opponents)
+{
+    for (std::size_t i = 0; i < players.ratings.size(); ++i)
     {
-        float C = A + (A - B) * fA / (fB - fA);
-        float fC = VolatilityFunction(C, delta, phi, variance, a);
+        Glicko2Rating playerRating(players.ratings[i], players.ratingDeviations[i], players.volatilities[i]);
+        std::size_t begin = opponents.offsets[i];
+        std::size_t end = opponents.offsets[i + 1];
 
-        if (fC * fB <= 0.0f)
+        Glicko2Rating newRating;
+        if (begin == end)
         {
-            A = B;
-            fA = fB;
+            newRating = UpdateInactiveRating(playerRating);
         }
         else
         {
-            fA = fA / 2.0f;
+            float mu = ConvertRatingToGlicko2(playerRating.rating);
+            OpponentSums sums = AccumulateOpponents(mu, &opponents.ratings[begin], &opponents.ratingDeviations[begin],
+                                                    &opponents.scores[begin], 1, end - begin);
+
+            newRating = ApplyOpponentSums(playerRating, sums);
         }
 
-        B = C;
-        fB = fC;
+        players.ratings[i] = newRating.rating;
+        players.ratingDeviations[i] = newRating.ratingDeviation;
+        players.volatilities[i] = newRating.volatility;
     }
-
-    return std::exp(A / 2.0f);
 }
 
-float Glicko2System::UpdateVolatility(float phi, float variance, float delta, float sigma) const
+void Glicko2System::UpdateRatingsBatch(Glicko2RatingBatch players, const Glicko2PreparedOpponent& opponent)
 {
-    float a = std::log(sigma * sigma);
-    return IllinoisAlgorithm(a, delta, phi, variance, sigma);
+    std::span<const Glicko2PreparedOpponent> opponents(&opponent, 1);
+
+    for (std::size_t i = 0; i < players.ratings.size(); ++i)
+    {
+        Glicko2Rating playerRating(players.ratings[i], players.ratingDeviations[i], players.volatilities[i]);
+        Glicko2Rating newRating = UpdateRating(playerRating, opponents);
+
+        players.ratings[i] = newRating.rating;
+        players.ratingDeviations[i] = newRating.ratingDeviation;
+        players.volatilities[i] = newRating.volatility;
+    }
 }
 
-Glicko2Rating Glicko2System::UpdateRating(const Glicko2Rating& playerRating,
-                                          const std::vector<Glicko2Opponent>& opponents)
+Glicko2Rating Glicko2System::ApplyOpponentSums(const Glicko2Rating& playerRating, OpponentSums const& sums) const
 {
-    // Handle edge case: no opponents
-    if (opponents.empty())
-        return UpdateInactiveRating(playerRating);
-
     // Step 2: Convert to Glicko-2 scale
     float mu = ConvertRatingToGlicko2(playerRating.rating);
     float phi = ConvertRDToGlicko2(playerRating.ratingDeviation);
     float sigma = playerRating.volatility;
 
     // Step 3: Calculate variance
-    float variance = CalculateVariance(mu, opponents);
+    float variance = sums.varianceSum > 0.0f ? 1.0f / sums.varianceSum : 0.0f;
 
     // Step 4: Calculate delta
-    float delta = CalculateDelta(mu, variance, opponents);
+    float delta = variance * sums.deltaSum;
 
     // Step 5: Update volatility
     float sigmaPrime = UpdateVolatility(phi, variance, delta, sigma);
@@ -196,15 +236,7 @@ Glicko2Rating Glicko2System::UpdateRating(const Glicko2Rating& playerRating,
 
     // Step 7: Update rating and RD
     float phiPrime = 1.0f / std::sqrt(1.0f / (phiStar * phiStar) + 1.0f / variance);
-
-    float sum = 0.0f;
-    for (auto const& opponent : opponents)
-    {
-        float muJ = ConvertRatingToGlicko2(opponent.rating);
-        float phiJ = ConvertRDToGlicko2(opponent.ratingDeviation);
-        sum += CalculateG(phiJ) * (opponent.score - CalculateE(mu, muJ, phiJ));
-    }
-    float muPrime = mu + phiPrime * phiPrime * sum;
+    float muPrime = mu + phiPrime * phiPrime * sums.deltaSum;
 
     // Step 8: Convert back to original scale
     Glicko2Rating newRating;
@@ -228,3 +260,75 @@ Glicko2Rating Glicko2System::UpdateInactiveRating(const Glicko2Rating& playerRat
 
     return newRating;
 }
+
+Glicko2Rating Glicko2System::UpdateInactiveRating(const Glicko2Rating& playerRating, uint32_t periods,
+                                                  float maxRatingDeviation) const
+{
+    // Never shrink an RD that is already above the cap
+    if (periods == 0 || playerRating.ratingDeviation >= maxRatingDeviation)
+        return playerRating;
+
+    float phi = ConvertRDToGlicko2(playerRating.ratingDeviation);
+    float sigma = playerRating.volatility;
+
+    float phiPrime = std::sqrt(phi * phi + static_cast<float>(periods) * sigma * sigma);
+
+    Glicko2Rating newRating = playerRating;
+    newRating.ratingDeviation = std::min(ConvertRDFromGlicko2(phiPrime), maxRatingDeviation);
+
+    return newRating;
+}
+
+float Glicko2System::ExpectedScore(const Glicko2Rating& player, const Glicko2Rating& opponent) const
+{
+    float gPhiJ = CalculateG(ConvertRDToGlicko2(opponent.ratingDeviation));
+    return CalculateE(ConvertRatingToGlicko2(player.rating), ConvertRatingToGlicko2(opponent.rating), gPhiJ);
+}
+
+void Glicko2System::ExpectedScore(const Glicko2Rating& player, std::span<const Glicko2Rating> opponents,
+                                  std::span<float> results) const
+{
+    std::size_t count = std::min(opponents.size(), results.size());
+    if (count == 0)
+        return;
+
+    // E() ignores the player's own RD; a broadcast zero makes the combined φ equal φj
+    const float noDeviation = 0.0f;
+    PredictPairings(&player.rating, &noDeviation, 0,
+                    &opponents[0].rating, &opponents[0].ratingDeviation, 3,
+                    count, results.data());
+}
+
+float Glicko2System::WinProbability(const Glicko2Rating& teamA, const Glicko2Rating& teamB) const
+{
+    float phiA = ConvertRDToGlicko2(teamA.ratingDeviation);
+    float phiB = ConvertRDToGlicko2(teamB.ratingDeviation);
+    float g = CalculateG(std::sqrt(phiA * phiA + phiB * phiB));
+    return CalculateE(ConvertRatingToGlicko2(teamA.rating), ConvertRatingToGlicko2(teamB.rating), g);
+}
+
+void Glicko2System::WinProbability(std::span<const Glicko2Rating> teamsA, std::span<const Glicko2Rating> teamsB,
+                                   std::span<float> results) const
+{
+    std::size_t count = std::min({ teamsA.size(), teamsB.size(), results.size() });
+    if (count == 0)
+        return;
+
+    PredictPairings(&teamsA[0].rating, &teamsA[0].ratingDeviation, 3,
+                    &teamsB[0].rating, &teamsB[0].ratingDeviation, 3,
+                    count, results.data());
+}
+
+void Glicko2System::PredictPairings(const float* ratingsA, const float* rdsA, std::size_t strideA,
+                                    const float* ratingsB, const float* rdsB, std::size_t strideB,
+                                    std::size_t count, float* results) const
+{
+    std::size_t done = Glicko2Simd::PredictBlocks(ratingsA, rdsA, strideA, ratingsB, rdsB, strideB, count, results);
+
+    for (std::size_t i = done; i < count; ++i)
+    {
+        Glicko2Rating teamA(ratingsA[i * strideA], rdsA[i * strideA], 0.0f);
+        Glicko2Rating teamB(ratingsB[i * strideB], rdsB[i * strideB], 0.0f);
+        results[i] = WinProbability(teamA, teamB);
+    }
+}
@@ -36,8 +36,12 @@
 #define _GLICKO2_H
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
+#include <span>
 #include <algorithm>
+#include "Glicko2Solver.h"
 
 /**
  * @brief Represents a player's Glicko-2 rating with uncertainty measures
@@ -83,6 +87,50 @@ struct Glicko2Opponent
     Glicko2Opponent(float r, float rd, float s) : rating(r), ratingDeviation(rd), score(s) {}
 };
 
+/**
+ * @brief Opponent already converted to the Glicko-2 scale
+ *
+ * Holds μ, φ and g(φ) so that every update against the same opponent (for
+ * example each member of a BG team facing the same opposing side) skips the
+ * scale conversion and the sqrt in g(φ). Build with
+ * Glicko2System::PrepareOpponent() once per match side.
+ */
+struct Glicko2PreparedOpponent
+{
+    float mu;               ///< Opponent's rating on Glicko-2 scale (μ)
+    float phi;              ///< Opponent's rating deviation on Glicko-2 scale (φ)
+    float gPhi;             ///< g(φ), the opponent's RD weighting factor
+    float score;            ///< Match score: 1.0 = win, 0.5 = draw, 0.0 = loss
+};
+
+/**
+ * @brief Structure-of-arrays view over the players of a batch update
+ *
+ * All three spans must have the same length. Values are read and written in
+ * place, so callers keep their own contiguous storage between batches.
+ */
+struct Glicko2RatingBatch
+{
+    std::span<float> ratings;           ///< Player ratings (r), updated in place
+    std::span<float> ratingDeviations;  ///< Player rating deviations (RD), updated in place
+    std::span<float> volatilities;      ///< Player volatilities (σ), updated in place
+};
+
+/**
+ * @brief Structure-of-arrays view over the opponent results of a batch update
+ *
+ * Results for player i are the entries in [offsets[i], offsets[i + 1]), so
+ * offsets holds one more element than there are players. The rating, RD and
+ * score spans are indexed by those entries.
+ */
+struct Glicko2OpponentBatch
+{
+    std::span<const std::size_t> offsets;       ///< Per-player start of results, plus a final end offset
+    std::span<const float> ratings;             ///< Opponent ratings
+    std::span<const float> ratingDeviations;    ///< Opponent rating deviations
+    std::span<const float> scores;              ///< Match scores (1.0 = win, 0.5 = draw, 0.0 = loss)
+};
+
 /**
  * @class Glicko2System
  * @brief Implements the Glicko-2 rating algorithm for skill-based matchmaking
@@ -137,6 +185,30 @@ public:
     Glicko2Rating UpdateRating(const Glicko2Rating& playerRating,
                                const std::vector<Glicko2Opponent>& opponents);
 
+    /**
+     * @brief Updates a player's rating against opponents prepared with PrepareOpponent()
+     * @param playerRating Current rating of the player
+     * @param opponents Prepared opponents with match outcomes
+     * @return New rating after processing all matches
+     *
+     * Skips the per-update scale conversion and g(φ) evaluation. Always runs
+     * the scalar loop, never the SIMD kernels, so it matches the Glicko2Opponent
+     * overload exactly only where that one stays scalar too (fewer opponents
+     * than one SIMD block, or Isa::Scalar). Otherwise the SIMD kernels' polynomial
+     * exp and lane-wise sums can move results by up to the bound the
+     * differential tests in tests/unit/Glicko2SimdTest.cpp accept: 0.01
+     * rating and RD points, 1e-5 volatility.
+     */
+    Glicko2Rating UpdateRating(const Glicko2Rating& playerRating,
+                               std::span<const Glicko2PreparedOpponent> opponents);
+
+    /**
+     * @brief Converts an opponent to the Glicko-2 scale and evaluates g(φ) once
+     * @param opponent Opponent rating, RD and match score
+     * @return Prepared opponent reusable across any number of updates
+     */
+    Glicko2PreparedOpponent PrepareOpponent(const Glicko2Opponent& opponent) const;
+
     /**
      * @brief Updates rating for an inactive player (increases uncertainty)
      * @param playerRating Current rating of the player
@@ -150,6 +222,83 @@ public:
      */
     Glicko2Rating UpdateInactiveRating(const Glicko2Rating& playerRating);
 
+    /**
+     * @brief Applies several idle rating periods at once
+     * @param playerRating Rating as of the player's last match
+     * @param periods Number of whole rating periods without a match
+     * @param maxRatingDeviation Upper bound for the resulting RD (original scale)
+     * @return Rating with φ' = sqrt(φ² + nσ²), rating and volatility unchanged
+     *
+     * Closed form of calling UpdateInactiveRating() n times, so RD can be
+     * brought up to date lazily when a rating is read.
+     */
+    Glicko2Rating UpdateInactiveRating(const Glicko2Rating& playerRating, uint32_t periods,
+                                       float maxRatingDeviation) const;
+
+    /**
+     * @brief Updates many players in one call from structure-of-arrays input
+     * @param players Ratings, RDs and volatilities of the players, updated in place
+     * @param opponents Per-player opponent results addressed through offsets
+     *
+     * Produces the same result as calling UpdateRating() once per player, but
+     * reads contiguous arrays instead of a std::vector<Glicko2Opponent> per
+     * player, so large recomputes do not allocate per update. Players with an
+     * empty result range are treated like UpdateInactiveRating().
+     */
+    void UpdateRatingsBatch(Glicko2RatingBatch players, Glicko2OpponentBatch const& opponents);
+
+    /**
+     * @brief Updates many players who all faced the same prepared opponent
+     * @param players Ratings, RDs and volatilities of the players, updated in place
+     * @param opponent Opposing side prepared once with PrepareOpponent()
+     *
+     * Covers the team case where each player's rating period is a single
+     * result against the averaged opposing team.
+     */
+    void UpdateRatingsBatch(Glicko2RatingBatch players, const Glicko2PreparedOpponent& opponent);
+
+    /**
+     * @brief Expected score of a player against one opponent, E(μ, μj, φj)
+     * @param player Player rating (the player's own RD does not enter E)
+     * @param opponent Opponent rating and RD
+     * @return Expected score in [0, 1], the same E the rating update uses
+     */
+    float ExpectedScore(const Glicko2Rating& player, const Glicko2Rating& opponent) const;
+
+    /**
+     * @brief Expected scores of one player against many opponents
+     * @param player Player rating
+     * @param opponents Opponent ratings and RDs
+     * @param results Receives one expected score per opponent
+     *
+     * Pairs beyond the shorter of opponents and results are ignored.
+     */
+    void ExpectedScore(const Glicko2Rating& player, std::span<const Glicko2Rating> opponents,
+                       std::span<float> results) const;
+
+    /**
+     * @brief Probability that side A beats side B
+     * @param teamA Rating and RD of side A (e.g. the average of a queued group)
+     * @param teamB Rating and RD of side B
+     * @return P(A wins) in [0, 1]; WinProbability(B, A) = 1 - WinProbability(A, B)
+     *
+     * Unlike ExpectedScore() both sides' uncertainty counts: g() is taken of
+     * the combined deviation sqrt(φA² + φB²), Glickman's outcome prediction.
+     */
+    float WinProbability(const Glicko2Rating& teamA, const Glicko2Rating& teamB) const;
+
+    /**
+     * @brief Win probabilities for many candidate pairings in one call
+     * @param teamsA Side A of each pairing
+     * @param teamsB Side B of each pairing
+     * @param results Receives P(teamsA[i] beats teamsB[i])
+     *
+     * Runs on the SIMD kernels, so a matchmaker can score hundreds of
+     * candidate pools per queue update. Pairs beyond the shortest span are ignored.
+     */
+    void WinProbability(std::span<const Glicko2Rating> teamsA, std::span<const Glicko2Rating> teamsB,
+                        std::span<float> results) const;
+
     /**
      * @brief Gets the system constant tau
      * @return Current tau value
@@ -162,6 +311,18 @@ public:
      */
     void SetTau(float tau) { _tau = tau; }
 
+    /**
+     * @brief Gets the volatility solver settings
+     * @return Solver mode and iteration cap
+     */
+    Glicko2SolverOptions const& GetSolverOptions() const { return _solverOptions; }
+
+    /**
+     * @brief Selects the volatility solver (reference or warm-started and capped)
+     * @param options Solver mode and iteration cap
+     */
+    void SetSolverOptions(Glicko2SolverOptions const& options) { _solverOptions = options; }
+
 private:
     /**
      * @brief Converts rating from original Glicko scale to Glicko-2 scale
@@ -198,31 +359,66 @@ private:
      */
     float CalculateG(float phi) const;
 
+    /**
+     * @brief Predicts pairings from strided rating/RD arrays (SIMD blocks, scalar remainder)
+     * @param strideA Distance in floats between side A entries (0 repeats the first)
+     * @param strideB Distance in floats between side B entries
+     */
+    void PredictPairings(const float* ratingsA, const float* rdsA, std::size_t strideA,
+                         const float* ratingsB, const float* rdsB, std::size_t strideB,
+                         std::size_t count, float* results) const;
+
     /**
      * @brief Calculates the E function (expected score against an opponent)
      * @param mu Player's rating on Glicko-2 scale
      * @param muJ Opponent's rating on Glicko-2 scale
-     * @param phiJ Opponent's rating deviation on Glicko-2 scale
+     * @param gPhiJ Precomputed g(φj) of the opponent
      * @return Expected score between 0 and 1
      */
-    float CalculateE(float mu, float muJ, float phiJ) const;
+    float CalculateE(float mu, float muJ, float gPhiJ) const;
+
+    /// @brief Per-opponent sums shared by steps 3, 4 and 7 of the algorithm
+    struct OpponentSums
+    {
+        float varianceSum;  ///< Σ g(φj)² E (1 - E), the inverse of the variance (v)
+        float deltaSum;     ///< Σ g(φj) (sj - E), scaled by v for Δ and by φ'² for μ'
+    };
 
     /**
-     * @brief Calculates the variance of the player's rating based on game outcomes
+     * @brief Fused opponent kernel: evaluates g(φj) and E once per opponent
      * @param mu Player's rating on Glicko-2 scale
-     * @param opponents Vector of opponents
-     * @return Variance (v) used in rating updates
+     * @param ratings First opponent rating
+     * @param rds First opponent rating deviation
+     * @param scores First match score
+     * @param stride Distance in floats between consecutive opponents
+     * @param count Number of opponents
+     * @return Variance and delta sums for the whole rating period
+     *
+     * Replaces separate variance, delta and step 7 passes over the opponents,
+     * which recomputed the same sqrt and exp three times per opponent. Whole
+     * blocks of opponents go through the SIMD kernel picked at startup (see
+     * Glicko2Simd.h); the remainder is evaluated here.
      */
-    float CalculateVariance(float mu, const std::vector<Glicko2Opponent>& opponents) const;
+    OpponentSums AccumulateOpponents(float mu, const float* ratings, const float* rds, const float* scores,
+                                     std::size_t stride, std::size_t count) const;
 
     /**
-     * @brief Calculates delta, the estimated improvement in rating
+     * @brief Adds one opponent's g(φj) and E terms to the running sums
+     * @param sums Sums being accumulated
      * @param mu Player's rating on Glicko-2 scale
-     * @param variance Calculated variance
-     * @param opponents Vector of opponents
-     * @return Delta (Δ) value
+     * @param rating Opponent's rating on original scale
+     * @param rd Opponent's rating deviation on original scale
+     * @param score Match score against the opponent
+     */
+    void AccumulateOpponent(OpponentSums& sums, float mu, float rating, float rd, float score) const;
+
+    /**
+     * @brief Runs steps 3 to 8 of the algorithm from accumulated opponent sums
+     * @param playerRating Current rating of the player
+     * @param sums Variance and delta sums over the rating period
+     * @return New rating
      */
-    float CalculateDelta(float mu, float variance, const std::vector<Glicko2Opponent>& opponents) const;
+    Glicko2Rating ApplyOpponentSums(const Glicko2Rating& playerRating, OpponentSums const& sums) const;
 
     /**
      * @brief Updates the volatility measure using iterative algorithm
@@ -245,6 +441,7 @@ private:
      *
      * This uses the Illinois variant of the regula falsi method, which is more
      * stable than the Newton-Raphson method previously used in Glicko-2.
+     * Bracketing and the iteration cap follow the configured solver options.
      */
     float IllinoisAlgorithm(float a, float delta, float phi, float variance, float sigma) const;
 
@@ -261,6 +458,7 @@ private:
 
     float _tau;      ///< System constant (τ) that constrains volatility changes
     float _epsilon;  ///< Convergence tolerance (ε) for iterative algorithms
+    Glicko2SolverOptions _solverOptions;  ///< Volatility solver mode and iteration cap
 
     static constexpr float SCALE_FACTOR = 173.7178f;  ///< Conversion factor between scales
     static constexpr float PI_SQUARED = 9.8696044f;   ///< π² constant used in calculations
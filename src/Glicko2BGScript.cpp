@@ -21,6 +21,8 @@
 #include "BattlegroundQueue.h"
 #include "Config.h"
 #include "Glicko2PlayerStorage.h"
+#include "Glicko2RatingPeriod.h"
+#include "Glicko2Static.h"
 #include "BattlegroundMMR.h"
 #include "ArenaMMR.h"
 #include "ArenaRatingStorage.h"
@@ -98,6 +100,8 @@ class Glicko2BGScript : public AllBattlegroundScript
     std::unordered_map<PoolKey, PoolTracker> _poolTracking;
     mutable std::mutex _poolMutex;
 
+    Glicko2System _predictor;   ///< Outcome predictions for the fairness gate (tau is not used)
+
 public:
     Glicko2BGScript() : AllBattlegroundScript("Glicko2BGScript")
     {
@@ -259,10 +263,10 @@ public:
         if (!sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false))
             return false;
 
-        BattlegroundRatingData data = sGlicko2Storage->GetRating(playerGuid);
-        if (data.loaded || data.matchesPlayed > 0)
+        Glicko2Rating rating;
+        if (sGlicko2Storage->FindMatchmakingRating(playerGuid, rating))
         {
-            outRating = data.rating;
+            outRating = rating.rating;
             return true;
         }
 
@@ -315,11 +319,12 @@ public:
                 return true;
             }
 
-            // Calculate average MMR of the group being considered
-            float groupAvgMMR = CalculateGroupArenaRating(group, bracket);
-
-            // Calculate average MMR of players already in pool
-            float poolAvgMMR = CalculatePoolArenaRating(pool.players, bracket);
+            // Average rating and RD of the group being considered and of the players already in pool
+            float initialRating = sArenaMMRMgr->GetInitialRating();
+            Glicko2Rating groupRating = AverageRating(sArenaRatingStorage->SumMatchmakingRatings(group->Players, bracket), initialRating);
+            Glicko2Rating poolRating = AverageRating(sArenaRatingStorage->SumMatchmakingRatings(pool.players, bracket), initialRating);
+            float groupAvgMMR = groupRating.rating;
+            float poolAvgMMR = poolRating.rating;
 
             // Calculate how long this group has been in queue
             uint32 queueTimeMS = GameTime::GetGameTimeMS().count() - group->JoinTime;
@@ -337,6 +342,11 @@ public:
             float mmrDiff = std::abs(groupAvgMMR - poolAvgMMR);
             bool allowed = mmrDiff <= currentRange;
 
+            // Optional gate on the predicted outcome, which also weighs rating uncertainty
+            float maxWinProbability = sArenaMMRMgr->GetMaxWinProbability();
+            if (allowed && maxWinProbability < 1.0f)
+                allowed = IsPredictedFair(groupRating, poolRating, maxWinProbability);
+
             LOG_DEBUG("module.glicko2", "[Glicko2 Arena] Bracket: {}, Group MMR: {:.1f}, Pool MMR: {:.1f}, Diff: {:.1f}, Range: {:.1f}, Queue: {}s - {}",
                 static_cast<uint8>(bracket), groupAvgMMR, poolAvgMMR, mmrDiff, currentRange, queueTimeSec, allowed ? "ALLOWED" : "REJECTED");
 
@@ -360,11 +370,11 @@ public:
             return true;
         }
 
-        // Calculate average MMR of the group being considered
-        float groupAvgMMR = CalculateGroupAverageMMR(group);
-
-        // Calculate average MMR of players already in pool
-        float poolAvgMMR = CalculatePoolAverageMMR(pool.players);
+        // Average rating and RD of the group being considered and of the players already in pool
+        Glicko2Rating groupRating = AverageRating(sGlicko2Storage->SumMatchmakingRatings(group->Players), 1500.0f);
+        Glicko2Rating poolRating = AverageRating(sGlicko2Storage->SumMatchmakingRatings(pool.players), 1500.0f);
+        float groupAvgMMR = groupRating.rating;
+        float poolAvgMMR = poolRating.rating;
 
         // Calculate how long this group has been in queue
         uint32 queueTimeMS = GameTime::GetGameTimeMS().count() - group->JoinTime;
@@ -382,6 +392,11 @@ public:
         float mmrDiff = std::abs(groupAvgMMR - poolAvgMMR);
         bool allowed = mmrDiff <= currentRange;
 
+        // Optional gate on the predicted outcome, which also weighs rating uncertainty
+        float maxWinProbability = sBattlegroundMMRMgr->GetMaxWinProbability();
+        if (allowed && maxWinProbability < 1.0f)
+            allowed = IsPredictedFair(groupRating, poolRating, maxWinProbability);
+
         LOG_DEBUG("module.glicko2", "[Glicko2 Matchmaking] Group MMR: {:.1f}, Pool MMR: {:.1f}, Diff: {:.1f}, Range: {:.1f}, Queue: {}s - {}",
             groupAvgMMR, poolAvgMMR, mmrDiff, currentRange, queueTimeSec, allowed ? "ALLOWED" : "REJECTED");
 
@@ -406,38 +421,81 @@ private:
         LOG_DEBUG("module.glicko2", "Processing BG rating updates for instance {} (winner: {})",
             bg->GetInstanceID(), match.winnerTeam == ALLIANCE ? "Alliance" : "Horde");
 
-        float allianceAvgMMR = CalculateAverageMMR(match.alliancePlayers);
-        float allianceAvgRD = CalculateAverageRD(match.alliancePlayers);
-        float hordeAvgMMR = CalculateAverageMMR(match.hordePlayers);
-        float hordeAvgRD = CalculateAverageRD(match.hordePlayers);
-
-        LOG_DEBUG("module.glicko2", "Team stats - Alliance: MMR={:.1f} RD={:.1f}, Horde: MMR={:.1f} RD={:.1f}",
-            allianceAvgMMR, allianceAvgRD, hordeAvgMMR, hordeAvgRD);
+        // With rating periods the ratings move when the period is committed
+        if (sGlicko2RatingPeriodMgr->IsEnabled())
+        {
+            RecordMatchResults(match);
+            LOG_DEBUG("module.glicko2", "BG results for instance {} recorded for the rating period", bg->GetInstanceID());
+            return;
+        }
 
-        UpdateTeamRatings(match.alliancePlayers, hordeAvgMMR, hordeAvgRD, match.winnerTeam == TEAM_ALLIANCE);
-        UpdateTeamRatings(match.hordePlayers, allianceAvgMMR, allianceAvgRD, match.winnerTeam == TEAM_HORDE);
+        // Production tau takes the compile-time specialized system
+        Glicko2SolverOptions const& solverOptions = sBattlegroundMMRMgr->GetSolverOptions();
+        float tau = sBattlegroundMMRMgr->GetMatchTau();
+        if (tau == Glicko2DefaultSystem::GetTau())
+        {
+            Glicko2DefaultSystem glicko;
+            glicko.SetSolverOptions(solverOptions);
+            RateMatch(glicko, match);
+        }
+        else
+        {
+            Glicko2System glicko(tau);
+            glicko.SetSolverOptions(solverOptions);
+            RateMatch(glicko, match);
+        }
 
         LOG_DEBUG("module.glicko2", "BG rating updates complete for instance {}", bg->GetInstanceID());
     }
 
-    float CalculateAverageMMR(std::unordered_set<ObjectGuid> const& players)
+    /**
+     * @brief Rate both teams of a finished match in one critical section
+     *
+     * Each side is averaged from the locked pre-match ratings before anyone
+     * is updated, so both teams are rated against the opponents they played.
+     */
+    template <typename System>
+    void RateMatch(System& glicko, MatchTracker const& match)
     {
-        if (players.empty())
-            return 1500.0f;
-
-        float totalMMR = 0.0f;
-        for (ObjectGuid guid : players)
+        bool allianceWon = match.winnerTeam == TEAM_ALLIANCE;
+        bool hordeWon = match.winnerTeam == TEAM_HORDE;
+
+        std::vector<ObjectGuid> guids = GetMatchPlayers(match);
+        size_t allianceCount = match.alliancePlayers.size();
+        std::vector<float> oldRatings(guids.size());
+        std::vector<float> newRatings(guids.size());
+        Glicko2Opponent allianceAverage(0.0f, 0.0f, 0.0f);
+        Glicko2Opponent hordeAverage(0.0f, 0.0f, 0.0f);
+        uint32 now = static_cast<uint32>(time(nullptr));
+
+        sGlicko2Storage->Update(guids, [&](std::span<BattlegroundRatingData> data)
         {
-            BattlegroundRatingData data = sGlicko2Storage->GetRating(guid);
-            totalMMR += data.rating;
-        }
+            std::span<BattlegroundRatingData> alliance = data.first(allianceCount);
+            std::span<BattlegroundRatingData> horde = data.subspan(allianceCount);
 
-        return totalMMR / static_cast<float>(players.size());
-    }
+            allianceAverage = AverageTeam(alliance, hordeWon ? 1.0f : 0.0f);
+            hordeAverage = AverageTeam(horde, allianceWon ? 1.0f : 0.0f);
 
-    float CalculatePoolAverageMMR(std::unordered_set<ObjectGuid> const& players)
-    {
-        return CalculateAverageMMR(players);
+            for (size_t i = 0; i < data.size(); ++i)
+                oldRatings[i] = data[i].rating;
+
+            // Convert each side once; every player on the other team reuses it
+            RateTeam(glicko, alliance, glicko.PrepareOpponent(hordeAverage), allianceWon, now);
+            RateTeam(glicko, horde, glicko.PrepareOpponent(allianceAverage), hordeWon, now);
+
+            for (size_t i = 0; i < data.size(); ++i)
+                newRatings[i] = data[i].rating;
+        });
+
+        LOG_DEBUG("module.glicko2", "Team stats - Alliance: MMR={:.1f} RD={:.1f}, Horde: MMR={:.1f} RD={:.1f}",
+            allianceAverage.rating, allianceAverage.ratingDeviation, hordeAverage.rating, hordeAverage.ratingDeviation);
+
+        for (size_t i = 0; i < guids.size(); ++i)
+        {
+            bool won = i < allianceCount ? allianceWon : hordeWon;
+            LOG_DEBUG("module.glicko2", "Player GUID {} rating updated: {:.1f} -> {:.1f} ({})",
+                guids[i].ToString(), oldRatings[i], newRatings[i], won ? "WIN" : "LOSS");
+        }
     }
 
     void CleanupStalePools()
@@ -462,57 +520,127 @@ private:
         if (!group || group->Players.empty())
             return sConfigMgr->GetOption<float>("Glicko2.InitialRating", 1500.0f);
 
-        float totalMMR = 0.0f;
-        for (ObjectGuid guid : group->Players)
+        return sGlicko2Storage->SumMatchmakingRatings(group->Players).GetAverageRating(0.0f);
+    }
+
+    /// @brief Batch-rate one team's locked ratings against the prepared other side and count the match
+    template <typename System>
+    static void RateTeam(System& glicko, std::span<BattlegroundRatingData> team,
+                         Glicko2PreparedOpponent const& opposingSide, bool won, uint32 now)
+    {
+        if (team.empty())
+            return;
+
+        // Lay the team out as structure-of-arrays so one batch call updates everyone
+        size_t count = team.size();
+        std::vector<float> ratings(count);
+        std::vector<float> ratingDeviations(count);
+        std::vector<float> volatilities(count);
+
+        for (size_t i = 0; i < count; ++i)
         {
-            BattlegroundRatingData data = sGlicko2Storage->GetRating(guid);
-            totalMMR += data.rating;
+            ratings[i] = team[i].rating;
+            ratingDeviations[i] = team[i].ratingDeviation;
+            volatilities[i] = team[i].volatility;
         }
 
-        return totalMMR / static_cast<float>(group->Players.size());
+        glicko.UpdateRatingsBatch({ ratings, ratingDeviations, volatilities }, opposingSide);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            team[i].rating = ratings[i];
+            team[i].ratingDeviation = ratingDeviations[i];
+            team[i].volatility = volatilities[i];
+            RecordMatchResult(team[i], won, now);
+        }
     }
 
-    float CalculateAverageRD(std::unordered_set<ObjectGuid> const& players)
+    /// @brief Count a finished match for both teams and queue each player's result for the rating period
+    void RecordMatchResults(MatchTracker const& match)
     {
-        if (players.empty())
-            return 200.0f;
+        bool allianceWon = match.winnerTeam == TEAM_ALLIANCE;
+        bool hordeWon = match.winnerTeam == TEAM_HORDE;
 
-        float totalRD = 0.0f;
-        for (ObjectGuid guid : players)
+        std::vector<ObjectGuid> guids = GetMatchPlayers(match);
+        size_t allianceCount = match.alliancePlayers.size();
+        Glicko2Opponent allianceAverage(0.0f, 0.0f, 0.0f);
+        Glicko2Opponent hordeAverage(0.0f, 0.0f, 0.0f);
+        uint32 now = static_cast<uint32>(time(nullptr));
+
+        // Averaged from the same locked ratings the counters are written to
+        sGlicko2Storage->Update(guids, [&](std::span<BattlegroundRatingData> data)
         {
-            BattlegroundRatingData data = sGlicko2Storage->GetRating(guid);
-            totalRD += data.ratingDeviation;
-        }
+            std::span<BattlegroundRatingData> alliance = data.first(allianceCount);
+            std::span<BattlegroundRatingData> horde = data.subspan(allianceCount);
+
+            allianceAverage = AverageTeam(alliance, hordeWon ? 1.0f : 0.0f);
+            hordeAverage = AverageTeam(horde, allianceWon ? 1.0f : 0.0f);
 
-        return totalRD / static_cast<float>(players.size());
+            for (BattlegroundRatingData& player : alliance)
+                RecordMatchResult(player, allianceWon, now);
+
+            for (BattlegroundRatingData& player : horde)
+                RecordMatchResult(player, hordeWon, now);
+        });
+
+        for (size_t i = 0; i < guids.size(); ++i)
+            sGlicko2RatingPeriodMgr->AddResult(guids[i], Glicko2RatingPool::BATTLEGROUND,
+                i < allianceCount ? hordeAverage : allianceAverage);
+    }
+
+    /// @brief Alliance players followed by Horde players, the layout RateMatch() and RecordMatchResults() split on
+    static std::vector<ObjectGuid> GetMatchPlayers(MatchTracker const& match)
+    {
+        std::vector<ObjectGuid> guids(match.alliancePlayers.begin(), match.alliancePlayers.end());
+        guids.insert(guids.end(), match.hordePlayers.begin(), match.hordePlayers.end());
+        return guids;
     }
 
-    void UpdateTeamRatings(std::unordered_set<ObjectGuid> const& players, float opponentAvgMMR, float opponentAvgRD, bool won)
+    /// @brief Average rating and RD of a locked team as the opponent the other side played; an empty team averages to the defaults
+    static Glicko2Opponent AverageTeam(std::span<BattlegroundRatingData const> team, float score)
     {
-        for (ObjectGuid guid : players)
+        if (team.empty())
         {
-            BattlegroundRatingData data = sGlicko2Storage->GetRating(guid);
+            Glicko2Rating defaults;
+            return Glicko2Opponent(defaults.rating, defaults.ratingDeviation, score);
+        }
 
-            Glicko2Rating oldRating(data.rating, data.ratingDeviation, data.volatility);
-            Glicko2Opponent opponent(opponentAvgMMR, opponentAvgRD, won ? 1.0f : 0.0f);
+        float totalRating = 0.0f;
+        float totalRD = 0.0f;
 
-            Glicko2System glicko(sConfigMgr->GetOption<float>("Glicko2.Tau", 0.5f));
-            Glicko2Rating newRating = glicko.UpdateRating(oldRating, { opponent });
+        for (BattlegroundRatingData const& data : team)
+        {
+            totalRating += data.rating;
+            totalRD += data.ratingDeviation;
+        }
 
-            data.rating = newRating.rating;
-            data.ratingDeviation = newRating.ratingDeviation;
-            data.volatility = newRating.volatility;
-            data.matchesPlayed++;
-            if (won)
-                data.wins++;
-            else
-                data.losses++;
+        float count = static_cast<float>(team.size());
+        return Glicko2Opponent(totalRating / count, totalRD / count, score);
+    }
 
-            sGlicko2Storage->SetRating(guid, data);
+    /// @brief Count one player's finished match
+    static void RecordMatchResult(BattlegroundRatingData& data, bool won, uint32 now)
+    {
+        data.matchesPlayed++;
+        data.lastMatchTime = now;
+        if (won)
+            data.wins++;
+        else
+            data.losses++;
+    }
 
-            LOG_DEBUG("module.glicko2", "Player GUID {} rating updated: {:.1f} -> {:.1f} ({})",
-                guid.ToString(), oldRating.rating, newRating.rating, won ? "WIN" : "LOSS");
-        }
+    /// @brief Whether neither side's predicted win probability exceeds the configured maximum
+    bool IsPredictedFair(Glicko2Rating const& group, Glicko2Rating const& pool, float maxWinProbability) const
+    {
+        float winProbability = _predictor.WinProbability(group, pool);
+        return std::max(winProbability, 1.0f - winProbability) <= maxWinProbability;
+    }
+
+    /// @brief Average rating and RD of a summed set of players; an empty set averages to the fallback rating
+    static Glicko2Rating AverageRating(Glicko2RatingSum const& sum, float fallbackRating)
+    {
+        return Glicko2Rating(sum.GetAverageRating(fallbackRating),
+                             sum.GetAverageRatingDeviation(Glicko2Rating().ratingDeviation), 0.0f);
     }
 
     /// @brief Check if group is queued for an arena
@@ -533,33 +661,10 @@ private:
     /// @brief Calculate average arena rating for a group
     float CalculateGroupArenaRating(GroupQueueInfo* group, ArenaBracket bracket)
     {
-        if (!group || group->Players.empty())
-            return sArenaMMRMgr->GetInitialRating();
-
-        float totalRating = 0.0f;
-        for (ObjectGuid guid : group->Players)
-        {
-            ArenaRatingData data = sArenaRatingStorage->GetRating(guid, bracket);
-            totalRating += data.rating;
-        }
-
-        return totalRating / static_cast<float>(group->Players.size());
-    }
-
-    /// @brief Calculate average arena rating for players in pool
-    float CalculatePoolArenaRating(std::unordered_set<ObjectGuid> const& players, ArenaBracket bracket)
-    {
-        if (players.empty())
+        if (!group)
             return sArenaMMRMgr->GetInitialRating();
 
-        float totalRating = 0.0f;
-        for (ObjectGuid guid : players)
-        {
-            ArenaRatingData data = sArenaRatingStorage->GetRating(guid, bracket);
-            totalRating += data.rating;
-        }
-
-        return totalRating / static_cast<float>(players.size());
+        return sArenaRatingStorage->SumMatchmakingRatings(group->Players, bracket).GetAverageRating(sArenaMMRMgr->GetInitialRating());
     }
 };
 
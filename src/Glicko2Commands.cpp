@@ -19,9 +19,13 @@
 #include "Language.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "ArenaRatingStorage.h"
 #include "BattlegroundMMR.h"
+#include "Glicko2Statements.h"
 #include "Glicko2PlayerStorage.h"
+#include "Glicko2Solver.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 
 using namespace Acore::ChatCommands;
 
@@ -38,6 +42,9 @@ public:
             { "info",    HandleBGMMRInfoCommand,    SEC_GAMEMASTER, Console::No },
             { "set",     HandleBGMMRSetCommand,     SEC_ADMINISTRATOR, Console::No },
             { "reset",   HandleBGMMRResetCommand,   SEC_ADMINISTRATOR, Console::No },
+            { "solverstats", HandleBGMMRSolverStatsCommand, SEC_GAMEMASTER, Console::Yes },
+            { "solverreset", HandleBGMMRSolverResetCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "cachestats", HandleBGMMRCacheStatsCommand, SEC_GAMEMASTER, Console::Yes },
         };
 
         static ChatCommandTable commandTable =
@@ -102,14 +109,16 @@ public:
             return false;
         }
 
-        BattlegroundRatingData bgRating = sGlicko2Storage->GetRating(target->GetGUID());
-        bgRating.rating = rating;
-        bgRating.ratingDeviation = 200.0f;
-        bgRating.volatility = 0.06f;
-        bgRating.loaded = true;
+        sGlicko2Storage->Update(target->GetGUID(), [rating](BattlegroundRatingData& bgRating)
+        {
+            bgRating.rating = rating;
+            bgRating.ratingDeviation = 200.0f;
+            bgRating.volatility = 0.06f;
+            bgRating.lastMatchTime = static_cast<uint32>(time(nullptr));
+            bgRating.loaded = true;
+        });
 
-        sGlicko2Storage->SetRating(target->GetGUID(), bgRating);
-        sGlicko2Storage->SaveRating(target->GetGUID(), bgRating);
+        sGlicko2Storage->SaveRating(target->GetGUID());
 
         handler->PSendSysMessage("Set {}'s Battleground MMR to {:.2f}", target->GetName(), rating);
 
@@ -142,15 +151,74 @@ public:
 
         sGlicko2Storage->SetRating(target->GetGUID(), bgRating);
 
-        CharacterDatabase.Execute("DELETE FROM character_battleground_rating WHERE guid = {}",
-                                   target->GetGUID().GetCounter());
-        CharacterDatabase.Execute("DELETE FROM character_battleground_rating_history WHERE guid = {}",
-                                   target->GetGUID().GetCounter());
+        Glicko2SqlBuilder stmt(GLICKO2_DEL_BG_RATING);
+        stmt.SetData(0, target->GetGUID().GetCounter());
+        CharacterDatabase.Execute(stmt.GetSql());
+
+        stmt = Glicko2SqlBuilder(GLICKO2_DEL_BG_RATING_HISTORY);
+        stmt.SetData(0, target->GetGUID().GetCounter());
+        CharacterDatabase.Execute(stmt.GetSql());
 
         handler->PSendSysMessage("Reset {}'s Battleground MMR to default values", target->GetName());
 
         return true;
     }
+
+    static bool HandleBGMMRSolverStatsCommand(ChatHandler* handler)
+    {
+        Glicko2SolverStats::Snapshot stats = sGlicko2SolverStats->GetSnapshot();
+
+        handler->PSendSysMessage("Volatility solver: {} solves, {} hit the iteration cap, worst case {} evaluations",
+                                 stats.calls, stats.capped, stats.maxEvaluations);
+
+        if (stats.calls == 0)
+            return true;
+
+        auto sendHistogram = [&](char const* label, std::array<uint64_t, Glicko2SolverStats::BUCKETS> const& buckets)
+        {
+            handler->PSendSysMessage("{}:", label);
+            for (size_t i = 0; i < buckets.size(); ++i)
+            {
+                if (!buckets[i])
+                    continue;
+
+                float percent = (static_cast<float>(buckets[i]) / stats.calls) * 100.0f;
+                handler->PSendSysMessage("  {}{}: {} ({:.1f}%)", i, i + 1 == buckets.size() ? "+" : "",
+                                         buckets[i], percent);
+            }
+        };
+
+        sendHistogram("Iterations per solve", stats.iterations);
+        sendHistogram("Bracketing evaluations per solve", stats.bracketing);
+
+        return true;
+    }
+
+    static bool HandleBGMMRSolverResetCommand(ChatHandler* handler)
+    {
+        sGlicko2SolverStats->Reset();
+        handler->SendSysMessage("Volatility solver statistics reset.");
+        return true;
+    }
+
+    static bool HandleBGMMRCacheStatsCommand(ChatHandler* handler)
+    {
+        auto sendStats = [&](char const* label, Glicko2CacheStats const& stats)
+        {
+            uint64_t lookups = stats.hits + stats.misses;
+            float hitRate = lookups ? (static_cast<float>(stats.hits) / lookups) * 100.0f : 0.0f;
+
+            handler->PSendSysMessage("{} cache: {} entries of {} ({:.1f} MB), {} hits, {} misses ({:.1f}% hit rate), {} evicted",
+                                     label, stats.entries,
+                                     stats.capacity ? std::to_string(stats.capacity) : std::string("unbounded"),
+                                     stats.memoryUsage / (1024.0f * 1024.0f), stats.hits, stats.misses, hitRate,
+                                     stats.evictions);
+        };
+
+        sendStats("BG", sGlicko2Storage->GetCacheStats());
+        sendStats("Arena", sArenaRatingStorage->GetCacheStats());
+        return true;
+    }
 };
 
 void AddGlicko2CommandScripts()
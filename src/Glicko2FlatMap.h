@@ -0,0 +1,278 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_FLAT_MAP_H
+#define _GLICKO2_FLAT_MAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Open-addressing hash map with values stored inline
+ *
+ * Built for the rating caches: keys are GUID counters (or counters packed
+ * with a bracket), so a lookup is one multiply, a shift and a linear probe
+ * over a contiguous slot array, with no per-entry allocation. Erase uses
+ * backward-shift deletion, so probe chains never accumulate tombstones
+ * across login/logout churn.
+ *
+ * Key 0 marks an empty slot and cannot be stored (no player has GUID
+ * counter 0). Inserting may move every entry; iterators and references are
+ * invalidated by try_emplace(), operator[] and erase(), as with
+ * std::unordered_map rehashes.
+ */
+template <typename Key, typename Value>
+class Glicko2FlatMap
+{
+    static_assert(std::is_unsigned_v<Key>, "Glicko2FlatMap keys are GUID counters");
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+
+    static constexpr Key EMPTY_KEY = 0;
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Glicko2FlatMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+        using reference = std::conditional_t<Const, value_type const&, value_type&>;
+
+        Iterator() = default;
+        Iterator(pointer slot, pointer end) : _slot(slot), _end(end) { SkipEmpty(); }
+
+        /// Non-const to const conversion
+        operator Iterator<true>() const requires (!Const) { return Iterator<true>(_slot, _end); }
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        Iterator& operator++()
+        {
+            ++_slot;
+            SkipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(Iterator const& other) const { return _slot == other._slot; }
+
+    private:
+        void SkipEmpty()
+        {
+            while (_slot != _end && _slot->first == EMPTY_KEY)
+                ++_slot;
+        }
+
+        pointer _slot = nullptr;
+        pointer _end = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    Glicko2FlatMap() = default;
+
+    Glicko2FlatMap(Glicko2FlatMap&& other) noexcept { swap(other); }
+
+    Glicko2FlatMap& operator=(Glicko2FlatMap&& other) noexcept
+    {
+        Glicko2FlatMap moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    iterator begin() { return iterator(_slots.get(), _slots.get() + capacity()); }
+    iterator end() { return iterator(_slots.get() + capacity(), _slots.get() + capacity()); }
+    const_iterator begin() const { return const_iterator(_slots.get(), _slots.get() + capacity()); }
+    const_iterator end() const { return const_iterator(_slots.get() + capacity(), _slots.get() + capacity()); }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return !_size; }
+    std::size_t capacity() const { return _slots ? _mask + 1 : 0; }
+
+    /// @brief Bytes held by the slot array
+    std::size_t GetMemoryUsage() const { return capacity() * sizeof(value_type); }
+
+    iterator find(Key key)
+    {
+        std::size_t pos = FindSlot(key);
+        return pos == NOT_FOUND ? end() : iterator(_slots.get() + pos, _slots.get() + capacity());
+    }
+
+    const_iterator find(Key key) const
+    {
+        std::size_t pos = FindSlot(key);
+        return pos == NOT_FOUND ? end() : const_iterator(_slots.get() + pos, _slots.get() + capacity());
+    }
+
+    bool contains(Key key) const { return FindSlot(key) != NOT_FOUND; }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key key, Args&&... args)
+    {
+        assert(key != EMPTY_KEY);
+
+        std::size_t pos = FindSlot(key);
+        if (pos != NOT_FOUND)
+            return { iterator(_slots.get() + pos, _slots.get() + capacity()), false };
+
+        // Up to 7/8 full: GUID counters are dense, and Fibonacci hashing
+        // spreads consecutive keys evenly, so probe chains stay short
+        if ((_size + 1) * 8 > capacity() * 7)
+            Rehash(std::max(MIN_CAPACITY, capacity() * 2));
+
+        pos = GetHomeSlot(key);
+        while (_slots[pos].first != EMPTY_KEY)
+            pos = (pos + 1) & _mask;
+
+        _slots[pos].first = key;
+        _slots[pos].second = Value(std::forward<Args>(args)...);
+        ++_size;
+        return { iterator(_slots.get() + pos, _slots.get() + capacity()), true };
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Key key, Args&&... args)
+    {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    Value& operator[](Key key) { return try_emplace(key).first->second; }
+
+    std::size_t erase(Key key)
+    {
+        std::size_t pos = FindSlot(key);
+        if (pos == NOT_FOUND)
+            return 0;
+
+        // Backward-shift: pull later entries of the chain into the hole
+        std::size_t hole = pos;
+        for (std::size_t next = (hole + 1) & _mask; _slots[next].first != EMPTY_KEY; next = (next + 1) & _mask)
+        {
+            std::size_t home = GetHomeSlot(_slots[next].first);
+            if (((next - home) & _mask) >= ((next - hole) & _mask))
+            {
+                _slots[hole] = std::move(_slots[next]);
+                hole = next;
+            }
+        }
+
+        _slots[hole].first = EMPTY_KEY;
+        _slots[hole].second = Value();
+        --_size;
+        return 1;
+    }
+
+    void clear()
+    {
+        _slots.reset();
+        _mask = 0;
+        _shift = 64;
+        _size = 0;
+    }
+
+    /// @brief Sizes the table for count entries without further growth
+    void reserve(std::size_t count)
+    {
+        std::size_t needed = std::bit_ceil(std::max(MIN_CAPACITY, (count * 8 + 6) / 7));
+        if (needed > capacity())
+            Rehash(needed);
+    }
+
+    void swap(Glicko2FlatMap& other) noexcept
+    {
+        std::swap(_slots, other._slots);
+        std::swap(_mask, other._mask);
+        std::swap(_shift, other._shift);
+        std::swap(_size, other._size);
+    }
+
+private:
+    static constexpr std::size_t NOT_FOUND = ~std::size_t(0);
+
+    /// Fibonacci hashing: the top bits of key * 2^64/phi
+    std::size_t GetHomeSlot(Key key) const
+    {
+        uint64_t hash = static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::size_t>(hash >> _shift);
+    }
+
+    std::size_t FindSlot(Key key) const
+    {
+        if (!_size || key == EMPTY_KEY)
+            return NOT_FOUND;
+
+        for (std::size_t pos = GetHomeSlot(key);; pos = (pos + 1) & _mask)
+        {
+            Key slotKey = _slots[pos].first;
+            if (slotKey == key)
+                return pos;
+
+            if (slotKey == EMPTY_KEY)
+                return NOT_FOUND;
+        }
+    }
+
+    void Rehash(std::size_t newCapacity)
+    {
+        std::size_t oldCapacity = capacity();
+        std::unique_ptr<value_type[]> oldSlots = std::move(_slots);
+
+        _slots = std::make_unique<value_type[]>(newCapacity);
+        _mask = newCapacity - 1;
+        _shift = 64 - std::countr_zero(newCapacity);
+
+        for (std::size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldSlots[i].first == EMPTY_KEY)
+                continue;
+
+            std::size_t pos = GetHomeSlot(oldSlots[i].first);
+            while (_slots[pos].first != EMPTY_KEY)
+                pos = (pos + 1) & _mask;
+
+            _slots[pos] = std::move(oldSlots[i]);
+        }
+    }
+
+    std::unique_ptr<value_type[]> _slots;
+    std::size_t _mask = 0;
+    int _shift = 64;
+    std::size_t _size = 0;
+};
+
+#endif // _GLICKO2_FLAT_MAP_H
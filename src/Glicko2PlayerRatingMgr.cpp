@@ -0,0 +1,261 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2PlayerRatingMgr.h"
+#include "ArenaRatingStorage.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "Glicko2Statements.h"
+#include "Glicko2PlayerStorage.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <optional>
+#include <thread>
+#include <vector>
+
+Glicko2PlayerRatingMgr* Glicko2PlayerRatingMgr::instance()
+{
+    static Glicko2PlayerRatingMgr instance;
+    return &instance;
+}
+
+void Glicko2PlayerRatingMgr::LoadPlayer(ObjectGuid playerGuid)
+{
+    sGlicko2Storage->SetOnline(playerGuid, true);
+    sArenaRatingStorage->SetOnline(playerGuid, true);
+
+    // Either storage may have evicted the player since the last session
+    bool loadBattleground = sGlicko2Storage->BeginLoad(playerGuid);
+    bool loadArena = sArenaRatingStorage->BeginLoad(playerGuid);
+    if (!loadBattleground && !loadArena)
+        return;
+
+    Glicko2SqlBuilder stmt(GLICKO2_SEL_LOGIN_RATINGS);
+    stmt.SetData(0, playerGuid.GetCounter());
+    stmt.SetData(1, playerGuid.GetCounter());
+
+    std::lock_guard guard(_queryLock);
+    _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(stmt.GetSql()).WithCallback([this, playerGuid](QueryResult result)
+    {
+        HandleLoadResult(playerGuid, std::move(result));
+    }));
+}
+
+void Glicko2PlayerRatingMgr::HandleLoadResult(ObjectGuid playerGuid, QueryResult result)
+{
+    std::optional<BattlegroundRatingData> bgRating;
+
+    if (result)
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            uint8 slotId = fields[0].Get<uint8>();
+
+            if (slotId == GLICKO2_BG_LOGIN_SLOT)
+            {
+                bgRating = Glicko2PlayerStorage::ReadRating(fields + 1);
+                continue;
+            }
+
+            if (slotId >= static_cast<uint8>(ArenaBracket::MAX_SLOTS))
+            {
+                LOG_ERROR("module", "Glicko2PlayerRatingMgr::HandleLoadResult: Invalid slot {} for player {}",
+                    slotId, playerGuid.ToString());
+                continue;
+            }
+
+            ArenaBracket bracket = static_cast<ArenaBracket>(slotId);
+            sArenaRatingStorage->CompleteLoad(playerGuid, bracket, ArenaRatingStorage::ReadRating(fields + 1, bracket));
+
+        } while (result->NextRow());
+    }
+
+    sArenaRatingStorage->CompleteLoad(playerGuid);
+
+    // Defaults are only written once the player actually has a result
+    sGlicko2Storage->CompleteLoad(playerGuid, bgRating ? *bgRating : sGlicko2Storage->GetDefaultRating());
+}
+
+void Glicko2PlayerRatingMgr::SavePlayer(ObjectGuid playerGuid)
+{
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+    sGlicko2Storage->SaveRating(playerGuid, trans);
+    sArenaRatingStorage->SaveAllRatings(playerGuid, trans);
+
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+}
+
+void Glicko2PlayerRatingMgr::UnloadPlayer(ObjectGuid playerGuid)
+{
+    SavePlayer(playerGuid);
+
+    // Saved and offline: the entries stay cached until a full shard evicts them
+    sGlicko2Storage->SetOnline(playerGuid, false);
+    sArenaRatingStorage->SetOnline(playerGuid, false);
+}
+
+void Glicko2PlayerRatingMgr::ProcessQueryCallbacks()
+{
+    std::lock_guard guard(_queryLock);
+    _queryProcessor.ProcessReadyCallbacks();
+}
+
+void Glicko2PlayerRatingMgr::LoadConfig()
+{
+    _preloadEnabled = sConfigMgr->GetOption<bool>("Glicko2.Preload.Enable", false);
+    _preloadWindowDays = sConfigMgr->GetOption<uint32>("Glicko2.Preload.WindowDays", 14);
+    _preloadPageSize = std::max<uint32>(sConfigMgr->GetOption<uint32>("Glicko2.Preload.PageSize", 20000), 1);
+    _preloadParallel = std::max<uint32>(sConfigMgr->GetOption<uint32>("Glicko2.Preload.Parallel", 4), 1);
+}
+
+void Glicko2PlayerRatingMgr::Preload()
+{
+    if (!_preloadEnabled)
+        return;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Pages cover GUID ranges, so they are independent and can run on several pool connections
+    QueryResult range = CharacterDatabase.Query(Glicko2SqlBuilder(GLICKO2_SEL_PRELOAD_RANGE).GetSql());
+    if (!range)
+        return;
+
+    Field* fields = range->Fetch();
+    uint64 lastGuid = std::max(fields[0].Get<uint32>(), fields[1].Get<uint32>());
+
+    uint32 now = static_cast<uint32>(time(nullptr));
+    uint32 window = std::min<uint64>(uint64(_preloadWindowDays) * 24 * 60 * 60, now);
+    uint32 since = now - window;
+
+    PreloadProgress progress;
+    QueryCallbackProcessor processor;
+    uint32 inFlight = 0;
+    uint64 nextGuid = 1;
+
+    for (;;)
+    {
+        // Stop paging once both caches are out of room; pages already in flight are still offered
+        while (inFlight < _preloadParallel && nextGuid <= lastGuid && !IsPreloadFull())
+        {
+            uint64 pageLast = std::min<uint64>(nextGuid + _preloadPageSize - 1, lastGuid);
+
+            Glicko2SqlBuilder stmt(GLICKO2_SEL_PRELOAD_RATINGS);
+            stmt.SetData(0, nextGuid);
+            stmt.SetData(1, pageLast);
+            stmt.SetData(2, since);
+            stmt.SetData(3, nextGuid);
+            stmt.SetData(4, pageLast);
+            stmt.SetData(5, since);
+
+            ++inFlight;
+            processor.AddCallback(CharacterDatabase.AsyncQuery(stmt.GetSql()).WithCallback([&progress, &inFlight](QueryResult result)
+            {
+                HandlePreloadResult(std::move(result), progress);
+                --inFlight;
+            }));
+
+            nextGuid = pageLast + 1;
+        }
+
+        if (!inFlight)
+            break;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        processor.ProcessReadyCallbacks();
+    }
+
+    if (nextGuid <= lastGuid)
+        LOG_INFO("server.loading", ">> Glicko2: Preload stopped at GUID {} of {}, both rating caches reached their memory budget",
+            nextGuid - 1, lastGuid);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    LOG_INFO("server.loading", ">> Glicko2: Preloaded {} BG ratings and {} arena players active in the last {} days in {} ms ({} refused by full shards)",
+        progress.battleground, progress.arena, _preloadWindowDays, elapsed.count(), progress.skipped);
+}
+
+void Glicko2PlayerRatingMgr::HandlePreloadResult(QueryResult result, PreloadProgress& progress)
+{
+    if (!result)
+        return;
+
+    // Rows come ordered by GUID; a player's arena brackets are cached together or not at all
+    ObjectGuid arenaGuid;
+    std::vector<ArenaRatingData> brackets;
+
+    auto flushArena = [&]()
+    {
+        if (brackets.empty())
+            return;
+
+        if (sArenaRatingStorage->PreloadRatings(arenaGuid, brackets))
+            ++progress.arena;
+        else
+            progress.skipped += brackets.size();
+
+        brackets.clear();
+    };
+
+    do
+    {
+        Field* fields = result->Fetch();
+        ObjectGuid playerGuid = ObjectGuid::Create<HighGuid::Player>(fields[0].Get<uint32>());
+        uint8 slotId = fields[1].Get<uint8>();
+
+        if (playerGuid != arenaGuid)
+        {
+            flushArena();
+            arenaGuid = playerGuid;
+        }
+
+        if (slotId == GLICKO2_BG_LOGIN_SLOT)
+        {
+            if (sGlicko2Storage->PreloadRating(playerGuid, Glicko2PlayerStorage::ReadRating(fields + 2)))
+                ++progress.battleground;
+            else
+                ++progress.skipped;
+
+            continue;
+        }
+
+        if (slotId >= static_cast<uint8>(ArenaBracket::MAX_SLOTS))
+        {
+            LOG_ERROR("module", "Glicko2PlayerRatingMgr::HandlePreloadResult: Invalid slot {} for player {}",
+                slotId, playerGuid.ToString());
+            continue;
+        }
+
+        brackets.push_back(ArenaRatingStorage::ReadRating(fields + 2, static_cast<ArenaBracket>(slotId)));
+
+    } while (result->NextRow());
+
+    flushArena();
+}
+
+bool Glicko2PlayerRatingMgr::IsPreloadFull()
+{
+    auto isFull = [](Glicko2CacheStats const& stats)
+    {
+        return stats.capacity && stats.entries >= stats.capacity - stats.capacity / 8;
+    };
+
+    return isFull(sGlicko2Storage->GetCacheStats()) && isFull(sArenaRatingStorage->GetCacheStats());
+}
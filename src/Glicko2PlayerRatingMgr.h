@@ -0,0 +1,101 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLICKO2_PLAYER_RATING_MGR_H
+#define GLICKO2_PLAYER_RATING_MGR_H
+
+#include "ObjectGuid.h"
+#include "DatabaseEnvFwd.h"
+#include "QueryCallbackProcessor.h"
+#include <mutex>
+
+/**
+ * @brief Loads and saves a player's BG and arena ratings together
+ *
+ * Login fetches the character_battleground_rating row and every
+ * character_arena_stats slot with one async query, so the world thread
+ * never waits on the DB. Until it lands the player is pending in
+ * Glicko2PlayerStorage and reads return starting ratings. Logout and
+ * autosave write both storages' changes in one transaction; logged in
+ * players are pinned in both caches, and a login reloads whichever
+ * storage evicted the player since their last session.
+ *
+ * At startup Preload() can warm both caches with players who played
+ * within a configured window, so the first queue pops after a restart
+ * do not score every queued player on defaults. The GUID space is read
+ * in pages, several in flight on the async pool at once, until the rows
+ * run out or both caches reach their memory budget.
+ */
+class Glicko2PlayerRatingMgr
+{
+public:
+    static Glicko2PlayerRatingMgr* instance();
+
+    /// Queue the login load; skipped when the player is already cached or loading
+    void LoadPlayer(ObjectGuid playerGuid);
+
+    /// Write the player's BG and arena ratings in one transaction
+    void SavePlayer(ObjectGuid playerGuid);
+
+    /// Save on logout and let both caches evict the player once they need the room
+    void UnloadPlayer(ObjectGuid playerGuid);
+
+    /// Run the callbacks of completed loads (world thread)
+    void ProcessQueryCallbacks();
+
+    /// Read the Glicko2.Preload.* settings
+    void LoadConfig();
+
+    /// Stream recently active players into both caches; blocks until every page landed (startup only)
+    void Preload();
+
+private:
+    Glicko2PlayerRatingMgr() = default;
+    ~Glicko2PlayerRatingMgr() = default;
+
+    Glicko2PlayerRatingMgr(Glicko2PlayerRatingMgr const&) = delete;
+    Glicko2PlayerRatingMgr& operator=(Glicko2PlayerRatingMgr const&) = delete;
+
+    /// Split a GLICKO2_SEL_LOGIN_RATINGS result into both storages
+    void HandleLoadResult(ObjectGuid playerGuid, QueryResult result);
+
+    /// @brief Rows taken and turned away by the preload
+    struct PreloadProgress
+    {
+        uint32 battleground = 0;    ///< BG ratings cached
+        uint32 arena = 0;           ///< Players whose arena brackets were cached
+        uint32 skipped = 0;         ///< Ratings refused by a full cache shard
+    };
+
+    /// Offer one GLICKO2_SEL_PRELOAD_RATINGS page to both storages
+    static void HandlePreloadResult(QueryResult result, PreloadProgress& progress);
+
+    /// Both caches are bounded and filled to their eviction target
+    static bool IsPreloadFull();
+
+    QueryCallbackProcessor _queryProcessor;
+    std::mutex _queryLock;                  ///< Guards _queryProcessor (logins and the world update)
+
+    bool _preloadEnabled = false;
+    uint32 _preloadWindowDays = 14;         ///< Players with a match this recent are preloaded
+    uint32 _preloadPageSize = 20000;        ///< GUIDs covered by one page query
+    uint32 _preloadParallel = 4;            ///< Page queries in flight at once
+};
+
+#define sGlicko2PlayerRatingMgr Glicko2PlayerRatingMgr::instance()
+
+#endif // GLICKO2_PLAYER_RATING_MGR_H
@@ -18,10 +18,13 @@
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Config.h"
+#include "ArenaRatingStorage.h"
+#include "Glicko2PlayerRatingMgr.h"
 #include "Glicko2PlayerStorage.h"
+#include "Glicko2RatingPeriod.h"
 #include "Log.h"
 
-/// @brief Handles loading and saving of player BG ratings
+/// @brief Handles loading and saving of player BG and arena ratings
 class Glicko2PlayerScript : public PlayerScript
 {
 public:
@@ -29,37 +32,49 @@ public:
 
     void OnPlayerLogin(Player* player) override
     {
-        if (!sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false))
+        if (!IsEnabled())
             return;
 
-        sGlicko2Storage->LoadRating(player->GetGUID());
-        LOG_DEBUG("module.glicko2", "[Glicko2] Player {} logged in, BG rating loaded.", player->GetName());
+        // Async: the world thread never waits on the DB during a login storm
+        sGlicko2PlayerRatingMgr->LoadPlayer(player->GetGUID());
+        LOG_DEBUG("module.glicko2", "[Glicko2] Player {} logged in, rating load queued.", player->GetName());
     }
 
     void OnPlayerLogout(Player* player) override
     {
-        if (!sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false))
+        // Fold this player's unfinished rating period in before it is saved
+        sGlicko2RatingPeriodMgr->CommitPlayer(player->GetGUID());
+
+        if (!IsEnabled())
             return;
 
-        sGlicko2Storage->SaveRating(player->GetGUID());
-        LOG_DEBUG("module.glicko2", "Player {} logged out, BG rating saved.", player->GetName());
+        sGlicko2PlayerRatingMgr->UnloadPlayer(player->GetGUID());
+        LOG_DEBUG("module.glicko2", "Player {} logged out, BG and arena ratings saved.", player->GetName());
     }
 
     void OnPlayerSave(Player* player) override
     {
-        if (!sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false))
+        if (!IsEnabled())
             return;
 
-        sGlicko2Storage->SaveRating(player->GetGUID());
+        sGlicko2PlayerRatingMgr->SavePlayer(player->GetGUID());
     }
 
     void OnPlayerDelete(ObjectGuid guid, uint32 /*accountId*/) override
     {
-        if (!sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false))
+        if (!IsEnabled())
             return;
 
         sGlicko2Storage->RemoveRating(guid);
-        LOG_DEBUG("module.glicko2", "Player GUID {} deleted, BG rating removed from cache.", guid.ToString());
+        sArenaRatingStorage->RemoveAllRatings(guid);
+        LOG_DEBUG("module.glicko2", "Player GUID {} deleted, ratings removed from cache.", guid.ToString());
+    }
+
+private:
+    static bool IsEnabled()
+    {
+        return sConfigMgr->GetOption<bool>("BattleGround.MMR.Enable", false) ||
+               sConfigMgr->GetOption<bool>("Glicko2.Arena.Enabled", false);
     }
 };
 
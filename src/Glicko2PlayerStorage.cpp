@@ -18,8 +18,19 @@
 #include "Glicko2PlayerStorage.h"
 #include "Player.h"
 #include "DatabaseEnv.h"
+#include "Glicko2Statements.h"
 #include "Log.h"
-#include "Config.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+Glicko2PlayerStorage::Glicko2PlayerStorage()
+{
+    // Built-in starting values until LoadConfig() publishes the configured ones
+    BattlegroundRatingData data;
+    SetDefaultRating(data.rating, data.ratingDeviation, data.volatility);
+}
 
 Glicko2PlayerStorage* Glicko2PlayerStorage::instance()
 {
@@ -29,57 +40,253 @@ Glicko2PlayerStorage* Glicko2PlayerStorage::instance()
 
 BattlegroundRatingData Glicko2PlayerStorage::GetRating(ObjectGuid playerGuid)
 {
-    std::shared_lock lock(_mutex);
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+    return ReadEntry(shard, playerGuid);
+}
+
+BattlegroundRatingData Glicko2PlayerStorage::ReadEntry(RatingCache::Shard const& shard, ObjectGuid playerGuid) const
+{
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    RatingCache::RecordLookup(shard, itr != shard.map.end());
+    if (itr != shard.map.end())
+    {
+        RatingCache::Touch(shard, itr->second.lastAccess);
+        return ApplyInactivityDecay(itr->second.data);
+    }
+
+    // Not cached, or its login load is still pending: matchmaking sees a starting rating
+    return *_defaultRating.load(std::memory_order_acquire);
+}
+
+Glicko2Rating Glicko2PlayerStorage::GetMatchmakingRating(ObjectGuid playerGuid) const
+{
+    return GetMatchmakingRating(playerGuid, GetReadContext());
+}
+
+Glicko2Rating Glicko2PlayerStorage::GetMatchmakingRating(ObjectGuid playerGuid, ReadContext const& context) const
+{
+    Glicko2Rating rating;
+    if (!FindMatchmakingRating(playerGuid, context, rating))
+    {
+        BattlegroundRatingData const* defaultData = context.defaultRating;
+        return Glicko2Rating(defaultData->rating, defaultData->ratingDeviation, defaultData->volatility);
+    }
+
+    return rating;
+}
+
+bool Glicko2PlayerStorage::FindMatchmakingRating(ObjectGuid playerGuid, Glicko2Rating& rating) const
+{
+    return FindMatchmakingRating(playerGuid, GetReadContext(), rating);
+}
 
-    auto itr = _ratings.find(playerGuid);
-    if (itr != _ratings.end())
-        return itr->second;
+bool Glicko2PlayerStorage::FindMatchmakingRating(ObjectGuid playerGuid, ReadContext const& context,
+    Glicko2Rating& rating) const
+{
+    Glicko2RatingSnapshot snapshot;
+    if (!_index.Find(playerGuid.GetCounter(), snapshot))
+        return false;
 
-    BattlegroundRatingData defaultData;
-    defaultData.rating = sConfigMgr->GetOption<float>("Glicko2.InitialRating", 1500.0f);
-    defaultData.ratingDeviation = sConfigMgr->GetOption<float>("Glicko2.InitialRatingDeviation", 350.0f);
-    defaultData.volatility = sConfigMgr->GetOption<float>("Glicko2.InitialVolatility", 0.06f);
-    return defaultData;
+    rating = Glicko2Rating(snapshot.rating, snapshot.ratingDeviation, snapshot.volatility);
+    rating.ratingDeviation = DecayRatingDeviation(rating, snapshot.lastMatchTime, context);
+    return true;
+}
+
+void Glicko2PlayerStorage::GetMatchmakingRatings(std::span<ObjectGuid const> playerGuids,
+    std::span<Glicko2Rating> ratings) const
+{
+    ReadContext context = GetReadContext();
+    for (size_t i = 0; i < playerGuids.size() && i < ratings.size(); ++i)
+        ratings[i] = GetMatchmakingRating(playerGuids[i], context);
+}
+
+Glicko2PlayerStorage::ReadContext Glicko2PlayerStorage::GetReadContext() const
+{
+    ReadContext context;
+    context.defaultRating = _defaultRating.load(std::memory_order_acquire);
+    context.decayPeriod = _decayPeriod.load(std::memory_order_relaxed);
+    context.maxRatingDeviation = _decayMaxRatingDeviation.load(std::memory_order_relaxed);
+    context.now = context.decayPeriod ? static_cast<uint32>(time(nullptr)) : 0;
+    return context;
 }
 
 void Glicko2PlayerStorage::SetRating(ObjectGuid playerGuid, BattlegroundRatingData const& data)
 {
-    std::unique_lock lock(_mutex);
-    _ratings[playerGuid] = data;
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+    WriteEntry(shard, playerGuid, data);
+}
+
+void Glicko2PlayerStorage::WriteEntry(RatingCache::Shard& shard, ObjectGuid playerGuid, BattlegroundRatingData const& data)
+{
+    if (!shard.map.contains(playerGuid.GetCounter()))
+        EvictIfFull(shard);
+
+    auto [itr, inserted] = shard.map.try_emplace(playerGuid.GetCounter());
+    CacheEntry& entry = itr->second;
+    RatingCache::Touch(shard, entry.lastAccess);
+    if (!inserted && entry.data == data)
+        return;
+
+    entry.data = data;
+    ++entry.version;
+    PublishRating(playerGuid, data);
 }
 
 bool Glicko2PlayerStorage::HasRating(ObjectGuid playerGuid)
 {
-    std::shared_lock lock(_mutex);
-    return _ratings.find(playerGuid) != _ratings.end();
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+    return shard.map.contains(playerGuid.GetCounter());
 }
 
 void Glicko2PlayerStorage::RemoveRating(ObjectGuid playerGuid)
 {
-    std::unique_lock lock(_mutex);
-    _ratings.erase(playerGuid);
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+    shard.map.erase(playerGuid.GetCounter());
+    _index.Remove(playerGuid.GetCounter());
+
+    std::lock_guard pendingGuard(_pendingLock);
+    _pending.erase(playerGuid);
 }
 
 void Glicko2PlayerStorage::LoadRating(ObjectGuid playerGuid)
 {
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
-        "FROM character_battleground_rating WHERE guid = {}", playerGuid.GetCounter());
+    Glicko2SqlBuilder stmt(GLICKO2_SEL_BG_RATING);
+    stmt.SetData(0, playerGuid.GetCounter());
+    QueryResult result = CharacterDatabase.Query(stmt.GetSql());
+
+    // Defaults are only written once the player actually has a result
+    BattlegroundRatingData data = result ? ReadRating(result->Fetch()) : GetDefaultRating();
+
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    if (!shard.map.contains(playerGuid.GetCounter()))
+        EvictIfFull(shard);
+
+    CacheEntry& entry = shard.map[playerGuid.GetCounter()];
+    entry = CacheEntry{ data, 0, 0 };
+    RatingCache::Touch(shard, entry.lastAccess);
+    PublishRating(playerGuid, data);
+
+    std::lock_guard pendingGuard(_pendingLock);
+    _pending.erase(playerGuid);
 
-    if (!result)
+    LOG_DEBUG("module.glicko2", "Loaded BG rating for player GUID {}: rating={:.1f}, RD={:.1f}, vol={:.4f}",
+        playerGuid.ToString(), data.rating, data.ratingDeviation, data.volatility);
+}
+
+bool Glicko2PlayerStorage::BeginLoad(ObjectGuid playerGuid)
+{
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+
+    // Every write goes through the cache, so a loaded entry kept from an earlier session is current;
+    // one holding only matches rated on the defaults still needs its row
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr != shard.map.end() && itr->second.data.loaded)
+        return false;
+
+    std::lock_guard pendingGuard(_pendingLock);
+    return _pending.insert(playerGuid).second;
+}
+
+void Glicko2PlayerStorage::CompleteLoad(ObjectGuid playerGuid, BattlegroundRatingData const& data)
+{
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    // Removed (character deleted, cache cleared) while the query was in flight
     {
-        BattlegroundRatingData data;
-        data.rating = sConfigMgr->GetOption<float>("Glicko2.InitialRating", 1500.0f);
-        data.ratingDeviation = sConfigMgr->GetOption<float>("Glicko2.InitialRatingDeviation", 350.0f);
-        data.volatility = sConfigMgr->GetOption<float>("Glicko2.InitialVolatility", 0.06f);
-        data.loaded = true;
+        std::lock_guard pendingGuard(_pendingLock);
+        if (!_pending.erase(playerGuid))
+            return;
+    }
+
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr != shard.map.end())
+    {
+        // A loaded rating set meanwhile (.bgmmr set) is newer than the row; keep it
+        CacheEntry& entry = itr->second;
+        if (entry.data.loaded)
+            return;
 
-        std::unique_lock lock(_mutex);
-        _ratings[playerGuid] = data;
+        // Matches finished while the query was in flight were rated on the defaults
+        BattlegroundRatingData merged = MergeLoadedRow(data, entry.data);
+        entry.data = merged;
+        entry.savedVersion = entry.version;
+        if (merged != data)
+            ++entry.version;    // Not in the DB yet
+
+        RatingCache::Touch(shard, entry.lastAccess);
+        PublishRating(playerGuid, merged);
         return;
     }
 
-    Field* fields = result->Fetch();
+    EvictIfFull(shard);
+
+    CacheEntry& entry = shard.map.try_emplace(playerGuid.GetCounter(), CacheEntry{ data, 0, 0 }).first->second;
+    RatingCache::Touch(shard, entry.lastAccess);
+    PublishRating(playerGuid, data);
+
+    LOG_DEBUG("module.glicko2", "Loaded BG rating for player GUID {}: rating={:.1f}, RD={:.1f}, vol={:.4f}",
+        playerGuid.ToString(), data.rating, data.ratingDeviation, data.volatility);
+}
+
+BattlegroundRatingData Glicko2PlayerStorage::MergeLoadedRow(BattlegroundRatingData row,
+    BattlegroundRatingData const& playedOnDefaults)
+{
+    // Without earlier matches the defaults were the player's rating, so that result stands
+    if (!row.matchesPlayed)
+    {
+        BattlegroundRatingData data = playedOnDefaults;
+        data.loaded = true;
+        return data;
+    }
+
+    // Otherwise it was rated from the wrong base: the row wins and only the counts carry over
+    row.matchesPlayed += playedOnDefaults.matchesPlayed;
+    row.wins += playedOnDefaults.wins;
+    row.losses += playedOnDefaults.losses;
+    row.lastMatchTime = std::max(row.lastMatchTime, playedOnDefaults.lastMatchTime);
+    return row;
+}
+
+bool Glicko2PlayerStorage::PreloadRating(ObjectGuid playerGuid, BattlegroundRatingData const& data)
+{
+    RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::unique_lock lock(shard.mutex);
+
+    // Whatever is cached already is at least as new as the row
+    if (shard.map.contains(playerGuid.GetCounter()))
+        return true;
+
+    if (_ratings.IsFull(shard))
+        return false;
+
+    CacheEntry& entry = shard.map.try_emplace(playerGuid.GetCounter(), CacheEntry{ data, 0, 0 }).first->second;
+    RatingCache::Touch(shard, entry.lastAccess);
+    PublishRating(playerGuid, data);
+    return true;
+}
+
+bool Glicko2PlayerStorage::IsPending(ObjectGuid playerGuid) const
+{
+    std::lock_guard pendingGuard(_pendingLock);
+    return _pending.contains(playerGuid);
+}
+
+size_t Glicko2PlayerStorage::GetPendingCount() const
+{
+    std::lock_guard pendingGuard(_pendingLock);
+    return _pending.size();
+}
+
+BattlegroundRatingData Glicko2PlayerStorage::ReadRating(Field* fields)
+{
     BattlegroundRatingData data;
     data.rating = fields[0].Get<float>();
     data.ratingDeviation = fields[1].Get<float>();
@@ -87,28 +294,67 @@ void Glicko2PlayerStorage::LoadRating(ObjectGuid playerGuid)
     data.matchesPlayed = fields[3].Get<uint32>();
     data.wins = fields[4].Get<uint32>();
     data.losses = fields[5].Get<uint32>();
+    data.lastMatchTime = fields[6].Get<uint32>();
     data.loaded = true;
+    return data;
+}
 
-    std::unique_lock lock(_mutex);
-    _ratings[playerGuid] = data;
+BattlegroundRatingData Glicko2PlayerStorage::GetDefaultRating() const
+{
+    BattlegroundRatingData data = *_defaultRating.load(std::memory_order_acquire);
+    data.loaded = true;
+    return data;
+}
 
-    LOG_DEBUG("module.glicko2", "Loaded BG rating for player GUID {}: rating={:.1f}, RD={:.1f}, vol={:.4f}",
-        playerGuid.ToString(), data.rating, data.ratingDeviation, data.volatility);
+void Glicko2PlayerStorage::SetDefaultRating(float rating, float ratingDeviation, float volatility)
+{
+    std::lock_guard guard(_defaultRatingLock);
+
+    BattlegroundRatingData const* current = _defaultRating.load(std::memory_order_relaxed);
+    if (current && current->rating == rating && current->ratingDeviation == ratingDeviation &&
+        current->volatility == volatility)
+        return;
+
+    auto data = std::make_unique<BattlegroundRatingData>();
+    data->rating = rating;
+    data->ratingDeviation = ratingDeviation;
+    data->volatility = volatility;
+
+    _defaultRatings.push_back(std::move(data));
+    _defaultRating.store(_defaultRatings.back().get(), std::memory_order_release);
+}
+
+std::vector<Glicko2PlayerStorage::PendingWrite> Glicko2PlayerStorage::CollectDirty(ObjectGuid playerGuid) const
+{
+    std::vector<PendingWrite> writes;
+
+    RatingCache::Shard const& shard = _ratings.GetShard(playerGuid.GetCounter());
+    std::shared_lock lock(shard.mutex);
+    auto itr = shard.map.find(playerGuid.GetCounter());
+    if (itr != shard.map.end() && itr->second.IsDirty())
+        writes.push_back({ playerGuid, itr->second.data, itr->second.version });
+
+    return writes;
 }
 
 void Glicko2PlayerStorage::SaveRating(ObjectGuid playerGuid)
 {
-    BattlegroundRatingData data;
-    {
-        std::shared_lock lock(_mutex);
-        auto itr = _ratings.find(playerGuid);
-        if (itr == _ratings.end() || !itr->second.loaded)
-            return;
+    std::vector<PendingWrite> writes = CollectDirty(playerGuid);
+    if (writes.empty())
+        return;
 
-        data = itr->second;
-    }
+    SaveRating(playerGuid, writes.front().data);
+    MarkSaved(writes);
+}
+
+void Glicko2PlayerStorage::SaveRating(ObjectGuid playerGuid, CharacterDatabaseTransaction trans)
+{
+    std::vector<PendingWrite> writes = CollectDirty(playerGuid);
+    if (writes.empty())
+        return;
 
-    SaveRating(playerGuid, data);
+    trans->Append(MakeSaveStatement(playerGuid, writes.front().data).GetSql().c_str());
+    MarkSaved(writes);
 }
 
 void Glicko2PlayerStorage::SaveRating(ObjectGuid playerGuid, BattlegroundRatingData const& data)
@@ -116,43 +362,223 @@ void Glicko2PlayerStorage::SaveRating(ObjectGuid playerGuid, BattlegroundRatingD
     if (!data.loaded)
         return;
 
-    CharacterDatabase.Execute(
-        "REPLACE INTO character_battleground_rating "
-        "(guid, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) "
-        "VALUES ({}, {}, {}, {}, {}, {}, {}, {})",
-        playerGuid.GetCounter(), data.rating, data.ratingDeviation, data.volatility,
-        data.matchesPlayed, data.wins, data.losses, static_cast<uint32>(time(nullptr)));
+    CharacterDatabase.Execute(MakeSaveStatement(playerGuid, data).GetSql());
 
     LOG_DEBUG("module.glicko2", "Saved BG rating for player GUID {}: rating={:.1f}, RD={:.1f}, matches={}",
         playerGuid.ToString(), data.rating, data.ratingDeviation, data.matchesPlayed);
 }
 
+Glicko2SqlBuilder Glicko2PlayerStorage::MakeSaveStatement(ObjectGuid playerGuid, BattlegroundRatingData const& data)
+{
+    Glicko2SqlBuilder stmt(GLICKO2_REP_BG_RATING);
+    stmt.SetData(0, playerGuid.GetCounter());
+    stmt.SetData(1, data.rating);
+    stmt.SetData(2, data.ratingDeviation);
+    stmt.SetData(3, data.volatility);
+    stmt.SetData(4, data.matchesPlayed);
+    stmt.SetData(5, data.wins);
+    stmt.SetData(6, data.losses);
+    stmt.SetData(7, data.lastMatchTime);
+    return stmt;
+}
+
 void Glicko2PlayerStorage::SaveAll()
 {
-    std::shared_lock lock(_mutex);
-    LOG_INFO("module.glicko2", "Saving all BG ratings ({} entries)...", _ratings.size());
+    std::vector<PendingWrite> writes;
+    size_t cached = 0;
+    size_t batchSize = std::max<uint32>(_saveBatchSize, 1);
 
-    for (auto const& [guid, data] : _ratings)
+    // One snapshot under every shard lock, so a team committed by a batch Update() is saved whole
     {
-        if (data.loaded)
+        auto locks = _ratings.LockAllShared();
+        _ratings.ForEachShard([&](RatingCache::Shard const& shard)
         {
-            SaveRating(guid, data);
-        }
+            cached += shard.map.size();
+
+            for (auto const& [counter, entry] : shard.map)
+                if (entry.IsDirty())
+                    writes.push_back({ ObjectGuid::Create<HighGuid::Player>(counter), entry.data, entry.version });
+        });
+    }
+
+    LOG_INFO("module.glicko2", "Saving BG ratings ({} changed of {} cached)...", writes.size(), cached);
+
+    // One transaction, one multi-row upsert per batch
+    if (!writes.empty())
+    {
+        std::span<PendingWrite const> pending(writes);
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+        for (size_t offset = 0; offset < pending.size(); offset += batchSize)
+            AppendBatch(trans, pending.subspan(offset, std::min(batchSize, pending.size() - offset)));
+
+        CharacterDatabase.CommitTransaction(trans);
+        MarkSaved(writes);
     }
 
     LOG_INFO("module.glicko2", "All BG ratings saved successfully.");
 }
 
+void Glicko2PlayerStorage::AppendBatch(CharacterDatabaseTransaction trans, std::span<PendingWrite const> writes)
+{
+    std::string sql =
+        "INSERT INTO character_battleground_rating "
+        "(guid, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) VALUES ";
+
+    size_t rows = 0;
+    for (PendingWrite const& write : writes)
+    {
+        // "nan" or "inf" would fail the whole transaction, and with it every other rating
+        BattlegroundRatingData const& data = write.data;
+        if (!std::isfinite(data.rating) || !std::isfinite(data.ratingDeviation) || !std::isfinite(data.volatility))
+        {
+            LOG_ERROR("module.glicko2", "Not saving BG rating of player GUID {}: rating={}, RD={}, vol={}",
+                write.guid.ToString(), data.rating, data.ratingDeviation, data.volatility);
+            continue;
+        }
+
+        fmt::format_to(std::back_inserter(sql), "{}({}, {}, {}, {}, {}, {}, {}, {})", rows++ ? ", " : "",
+            write.guid.GetCounter(), data.rating, data.ratingDeviation, data.volatility,
+            data.matchesPlayed, data.wins, data.losses, data.lastMatchTime);
+    }
+
+    if (!rows)
+        return;
+
+    sql += GLICKO2_RATING_UPSERT_UPDATE;
+    trans->Append(sql.c_str());
+}
+
+void Glicko2PlayerStorage::MarkSaved(std::vector<PendingWrite> const& writes)
+{
+    if (writes.empty())
+        return;
+
+    for (PendingWrite const& write : writes)
+    {
+        RatingCache::Shard& shard = _ratings.GetShard(write.guid.GetCounter());
+        std::unique_lock lock(shard.mutex);
+
+        auto itr = shard.map.find(write.guid.GetCounter());
+        if (itr != shard.map.end())
+            itr->second.savedVersion = std::max(itr->second.savedVersion, write.version);
+    }
+}
+
 void Glicko2PlayerStorage::ClearCache()
 {
-    std::unique_lock lock(_mutex);
-    size_t count = _ratings.size();
-    _ratings.clear();
+    size_t count = _ratings.Size();
+    _ratings.Clear();
+    _index.Clear();
+
+    {
+        std::lock_guard pendingGuard(_pendingLock);
+        _pending.clear();
+    }
+
     LOG_INFO("module.glicko2", "Cleared BG rating cache ({} entries removed).", count);
 }
 
 size_t Glicko2PlayerStorage::GetCacheSize() const
 {
-    std::shared_lock lock(_mutex);
-    return _ratings.size();
+    return _ratings.Size();
+}
+
+size_t Glicko2PlayerStorage::GetDirtyCount() const
+{
+    size_t dirty = 0;
+    _ratings.ForEachShard([&dirty](RatingCache::Shard const& shard)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (auto const& [counter, entry] : shard.map)
+            if (entry.IsDirty())
+                ++dirty;
+    });
+
+    return dirty;
+}
+
+void Glicko2PlayerStorage::SetSaveBatchSize(uint32 rows)
+{
+    _saveBatchSize = rows;
+}
+
+void Glicko2PlayerStorage::SetShardCount(uint32 shards)
+{
+    _ratings.Resize(shards);
+    _index.Resize(shards);
+}
+
+void Glicko2PlayerStorage::SetMemoryBudget(size_t bytes)
+{
+    // Worst case right after a table doubles: half-full slot arrays in both the map and the read index
+    constexpr size_t bytesPerEntry = 2 * (sizeof(RatingCache::Map::value_type) + Glicko2RatingIndex::GetSlotSize());
+    _ratings.SetCapacity(bytes ? std::max<size_t>(bytes / bytesPerEntry, 1) : 0);
+}
+
+void Glicko2PlayerStorage::SetOnline(ObjectGuid playerGuid, bool online)
+{
+    std::lock_guard onlineGuard(_onlineLock);
+    if (online)
+        _online.insert(playerGuid.GetCounter());
+    else
+        _online.erase(playerGuid.GetCounter());
+}
+
+void Glicko2PlayerStorage::EvictIfFull(RatingCache::Shard& shard)
+{
+    if (!_ratings.IsFull(shard))
+        return;
+
+    std::lock_guard onlineGuard(_onlineLock);
+
+    // Unsaved changes and logged in players stay; a later login reloads anything evicted
+    size_t evicted = _ratings.Evict(shard,
+        [this](ObjectGuid::LowType counter, CacheEntry const& entry)
+        {
+            return !entry.IsDirty() && !_online.contains(counter);
+        },
+        [this](ObjectGuid::LowType counter, CacheEntry const& /*entry*/)
+        {
+            _index.Remove(counter);
+        });
+
+    LOG_DEBUG("module.glicko2", "Evicted {} BG ratings from a full cache shard ({} left).", evicted, shard.map.size());
+}
+
+void Glicko2PlayerStorage::SetInactivityDecay(uint32 periodSeconds, float maxRatingDeviation)
+{
+    _decayPeriod = periodSeconds;
+    _decayMaxRatingDeviation = maxRatingDeviation;
+}
+
+BattlegroundRatingData Glicko2PlayerStorage::ApplyInactivityDecay(BattlegroundRatingData const& data) const
+{
+    BattlegroundRatingData result = data;
+    result.ratingDeviation = DecayRatingDeviation(
+        Glicko2Rating(data.rating, data.ratingDeviation, data.volatility), data.lastMatchTime, GetReadContext());
+    return result;
+}
+
+float Glicko2PlayerStorage::DecayRatingDeviation(Glicko2Rating const& rating, uint32 lastMatchTime,
+    ReadContext const& context) const
+{
+    if (!context.decayPeriod || !lastMatchTime || context.now <= lastMatchTime)
+        return rating.ratingDeviation;
+
+    uint32 periods = (context.now - lastMatchTime) / context.decayPeriod;
+    if (!periods)
+        return rating.ratingDeviation;
+
+    return _glicko.UpdateInactiveRating(rating, periods, context.maxRatingDeviation).ratingDeviation;
+}
+
+void Glicko2PlayerStorage::PublishRating(ObjectGuid playerGuid, BattlegroundRatingData const& data)
+{
+    Glicko2RatingSnapshot snapshot;
+    snapshot.rating = data.rating;
+    snapshot.ratingDeviation = data.ratingDeviation;
+    snapshot.volatility = data.volatility;
+    snapshot.lastMatchTime = data.lastMatchTime;
+    _index.Publish(playerGuid.GetCounter(), snapshot);
 }
@@ -20,8 +20,17 @@
 
 #include "ObjectGuid.h"
 #include "DatabaseEnvFwd.h"
-#include <unordered_map>
-#include <shared_mutex>
+#include "Glicko2.h"
+#include "Glicko2ShardedCache.h"
+#include "Glicko2RatingIndex.h"
+#include "Glicko2Statements.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <span>
+#include <vector>
 
 class Player;
 
@@ -34,6 +43,7 @@ struct BattlegroundRatingData
     uint32 matchesPlayed = 0;           ///< Total matches played
     uint32 wins = 0;                    ///< Total wins
     uint32 losses = 0;                  ///< Total losses
+    uint32 lastMatchTime = 0;           ///< Unix time of the last rated match (0 = never)
     bool loaded = false;                ///< Whether data is loaded from DB
 
     BattlegroundRatingData() = default;
@@ -41,6 +51,8 @@ struct BattlegroundRatingData
     BattlegroundRatingData(float r, float rd, float v, uint32 mp, uint32 w, uint32 l)
         : rating(r), ratingDeviation(rd), volatility(v),
           matchesPlayed(mp), wins(w), losses(l), loaded(true) { }
+
+    bool operator==(BattlegroundRatingData const& other) const = default;
 };
 
 /// @brief Thread-safe external storage for player battleground ratings
@@ -50,27 +62,236 @@ public:
     static Glicko2PlayerStorage* instance();
 
     BattlegroundRatingData GetRating(ObjectGuid playerGuid);
+
+    /// Rating, RD (decayed) and volatility for matchmaking, read without taking a cache lock
+    Glicko2Rating GetMatchmakingRating(ObjectGuid playerGuid) const;
+
+    /// GetMatchmakingRating() of an indexed player; false, leaving rating untouched, when the player is not indexed
+    bool FindMatchmakingRating(ObjectGuid playerGuid, Glicko2Rating& rating) const;
+
+    /// GetMatchmakingRating() of every player into ratings[i]; the clock and decay settings are read once
+    void GetMatchmakingRatings(std::span<ObjectGuid const> playerGuids, std::span<Glicko2Rating> ratings) const;
+
+    /// Summed matchmaking rating and RD of any range of player GUIDs, read without taking a cache lock
+    template <typename Range>
+    Glicko2RatingSum SumMatchmakingRatings(Range const& playerGuids) const
+    {
+        ReadContext context = GetReadContext();
+        Glicko2RatingSum sum;
+        for (ObjectGuid playerGuid : playerGuids)
+        {
+            Glicko2Rating rating = GetMatchmakingRating(playerGuid, context);
+            sum.Add(rating.rating, rating.ratingDeviation);
+        }
+
+        return sum;
+    }
+
     void SetRating(ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    /**
+     * @brief Read-modify-write of one rating under a single shard lock
+     *
+     * fn(BattlegroundRatingData&) sees what GetRating() would return and its
+     * result is stored as SetRating() would store it; nothing is written if
+     * fn leaves the data unchanged.
+     */
+    template <typename Function>
+    void Update(ObjectGuid playerGuid, Function&& fn)
+    {
+        RatingCache::Shard& shard = _ratings.GetShard(playerGuid.GetCounter());
+        std::unique_lock lock(shard.mutex);
+
+        BattlegroundRatingData const current = ReadEntry(shard, playerGuid);
+        BattlegroundRatingData data = current;
+        fn(data);
+
+        if (data != current)
+            WriteEntry(shard, playerGuid, data);
+    }
+
+    /**
+     * @brief Read-modify-write of several ratings in one critical section
+     *
+     * Every shard involved stays locked from the reads to the writes, so
+     * fn(std::span<BattlegroundRatingData>) can compute a whole match from
+     * consistent ratings; element i belongs to playerGuids[i].
+     */
+    template <typename Function>
+    void Update(std::span<ObjectGuid const> playerGuids, Function&& fn)
+    {
+        std::vector<ObjectGuid::LowType> counters(playerGuids.size());
+        std::transform(playerGuids.begin(), playerGuids.end(), counters.begin(),
+            [](ObjectGuid guid) { return guid.GetCounter(); });
+
+        auto locks = _ratings.LockShards(counters);
+
+        std::vector<BattlegroundRatingData> current;
+        current.reserve(playerGuids.size());
+        for (ObjectGuid playerGuid : playerGuids)
+            current.push_back(ReadEntry(_ratings.GetShard(playerGuid.GetCounter()), playerGuid));
+
+        std::vector<BattlegroundRatingData> data = current;
+        fn(std::span<BattlegroundRatingData>(data));
+
+        for (size_t i = 0; i < playerGuids.size(); ++i)
+            if (data[i] != current[i])
+                WriteEntry(_ratings.GetShard(counters[i]), playerGuids[i], data[i]);
+    }
+
     bool HasRating(ObjectGuid playerGuid);
     void RemoveRating(ObjectGuid playerGuid);
 
+    /// Load from the DB, blocking the calling thread
     void LoadRating(ObjectGuid playerGuid);
+
+    /// Mark an async load as started; false when the player's loaded entry is cached or a load is in flight
+    bool BeginLoad(ObjectGuid playerGuid);
+
+    /// Cache the result of an async load started with BeginLoad(); matches rated meanwhile are merged in
+    void CompleteLoad(ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    /// Cache a row read by the startup preload; false when its shard is full (nothing is evicted for it)
+    bool PreloadRating(ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    /// Whether an async load for the player is still outstanding
+    bool IsPending(ObjectGuid playerGuid) const;
+    size_t GetPendingCount() const;
+
+    /// Rating, RD, volatility, played, won, lost and last match time starting at fields[0]
+    static BattlegroundRatingData ReadRating(Field* fields);
+
+    /// Rating given to players without a row
+    BattlegroundRatingData GetDefaultRating() const;
+
+    /// Replace the rating, RD and volatility given to players without a row; readers switch over atomically
+    void SetDefaultRating(float rating, float ratingDeviation, float volatility);
+
+    /// Write the cached entry if it changed since it was loaded or last saved
     void SaveRating(ObjectGuid playerGuid);
+    void SaveRating(ObjectGuid playerGuid, CharacterDatabaseTransaction trans);
+
+    /// Write the given data unconditionally (does not touch the cache)
     void SaveRating(ObjectGuid playerGuid, BattlegroundRatingData const& data);
 
+    /// Write every changed entry from one snapshot of all shards; the DB work runs outside the locks
     void SaveAll();
     void ClearCache();
     size_t GetCacheSize() const;
 
+    /// Number of cached entries with changes not yet written to the DB
+    size_t GetDirtyCount() const;
+
+    /// Configure the lazy inactivity decay applied by GetRating() (period 0 disables it)
+    void SetInactivityDecay(uint32 periodSeconds, float maxRatingDeviation);
+
+    /// Rows per multi-row upsert written by SaveAll()
+    void SetSaveBatchSize(uint32 rows);
+
+    /// Number of independently locked cache shards (startup only)
+    void SetShardCount(uint32 shards);
+    size_t GetShardCount() const { return _ratings.GetShardCount(); }
+
+    /// Bound the cache to roughly this many bytes (0 = unbounded); clean offline entries are evicted LRU first
+    void SetMemoryBudget(size_t bytes);
+
+    /// Online players are never evicted
+    void SetOnline(ObjectGuid playerGuid, bool online);
+
+    /// Hit, miss and eviction counters of GetRating() and the cache size against its limit
+    Glicko2CacheStats GetCacheStats() const { return _ratings.GetStats(); }
+
 private:
-    Glicko2PlayerStorage() = default;
+    Glicko2PlayerStorage();
     ~Glicko2PlayerStorage() = default;
 
     Glicko2PlayerStorage(Glicko2PlayerStorage const&) = delete;
     Glicko2PlayerStorage& operator=(Glicko2PlayerStorage const&) = delete;
 
-    std::unordered_map<ObjectGuid, BattlegroundRatingData> _ratings;
-    mutable std::shared_mutex _mutex;
+    /// Row of a login load combined with the matches rated on the defaults while it was in flight
+    static BattlegroundRatingData MergeLoadedRow(BattlegroundRatingData row, BattlegroundRatingData const& playedOnDefaults);
+
+    /// Raise RD for every whole period since lastMatchTime; the stored entry is left untouched
+    BattlegroundRatingData ApplyInactivityDecay(BattlegroundRatingData const& data) const;
+
+    /// @brief Default template, clock and decay settings, loaded once per read or batch of reads
+    struct ReadContext
+    {
+        BattlegroundRatingData const* defaultRating = nullptr;
+        uint32 now = 0;                     ///< Only read when decayPeriod is set
+        uint32 decayPeriod = 0;
+        float maxRatingDeviation = 0.0f;
+    };
+
+    ReadContext GetReadContext() const;
+    Glicko2Rating GetMatchmakingRating(ObjectGuid playerGuid, ReadContext const& context) const;
+    bool FindMatchmakingRating(ObjectGuid playerGuid, ReadContext const& context, Glicko2Rating& rating) const;
+    float DecayRatingDeviation(Glicko2Rating const& rating, uint32 lastMatchTime, ReadContext const& context) const;
+
+    /// Copy the matchmaking fields into the read index; called under the entry's shard lock
+    void PublishRating(ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    /// @brief Cached rating plus write-behind bookkeeping
+    struct CacheEntry
+    {
+        BattlegroundRatingData data;
+        uint32 version = 0;             ///< Bumped by every SetRating() that changes data
+        uint32 savedVersion = 0;        ///< Version last written to (or read from) the DB
+        mutable uint32 lastAccess = 0;  ///< LRU stamp, written by reads under the shared lock
+
+        bool IsDirty() const { return data.loaded && version != savedVersion; }
+    };
+
+    /// @brief Entry captured for a flush
+    struct PendingWrite
+    {
+        ObjectGuid guid;
+        BattlegroundRatingData data;
+        uint32 version;
+    };
+
+    /// Copy the entry out if it has unsaved changes
+    std::vector<PendingWrite> CollectDirty(ObjectGuid playerGuid) const;
+
+    /// Single-row save statement
+    static Glicko2SqlBuilder MakeSaveStatement(ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    /// Append one multi-row upsert covering the given writes
+    static void AppendBatch(CharacterDatabaseTransaction trans, std::span<PendingWrite const> writes);
+
+    /// Record that the given versions reached the DB; entries changed meanwhile stay dirty
+    void MarkSaved(std::vector<PendingWrite> const& writes);
+
+    /// Keyed by GUID counter: every cached GUID is a player
+    using RatingCache = Glicko2ShardedCache<ObjectGuid::LowType, CacheEntry>;
+
+    /// Make room before inserting a new key; called under the shard's unique lock
+    void EvictIfFull(RatingCache::Shard& shard);
+
+    /// GetRating() and SetRating() under a shard lock the caller already holds (unique for WriteEntry)
+    BattlegroundRatingData ReadEntry(RatingCache::Shard const& shard, ObjectGuid playerGuid) const;
+    void WriteEntry(RatingCache::Shard& shard, ObjectGuid playerGuid, BattlegroundRatingData const& data);
+
+    RatingCache _ratings;
+    Glicko2RatingIndex _index;      ///< Matchmaking fields of every _ratings entry
+
+    /// Async loads in flight; taken after a shard lock, never before one
+    std::unordered_set<ObjectGuid> _pending;
+    mutable std::mutex _pendingLock;
+
+    /// Players logged in; taken after a shard lock, never before one
+    std::unordered_set<ObjectGuid::LowType> _online;
+    std::mutex _onlineLock;
+
+    /// Current default template; earlier ones stay alive for readers that loaded them
+    std::atomic<BattlegroundRatingData const*> _defaultRating = nullptr;
+    std::vector<std::unique_ptr<BattlegroundRatingData const>> _defaultRatings;
+    std::mutex _defaultRatingLock;
+
+    std::atomic<uint32> _saveBatchSize = 500;               ///< Rows per multi-row upsert in SaveAll()
+    std::atomic<uint32> _decayPeriod = 0;                   ///< Inactivity period length in seconds
+    std::atomic<float> _decayMaxRatingDeviation = 350.0f;   ///< RD never decays past this value
+    Glicko2System _glicko;
 };
 
 #define sGlicko2Storage Glicko2PlayerStorage::instance()
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2RatingIndex.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <utility>
+
+namespace
+{
+    /// Marks a stripe as being written; readers that saw the old value retry
+    uint32_t BeginWrite(std::atomic<uint32_t>& sequence)
+    {
+        uint32_t value = sequence.load(std::memory_order_relaxed);
+        sequence.store(value + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return value;
+    }
+
+    void EndWrite(std::atomic<uint32_t>& sequence, uint32_t value)
+    {
+        sequence.store(value + 2, std::memory_order_release);
+    }
+}
+
+Glicko2RatingIndex::Glicko2RatingIndex(std::size_t stripeCount)
+{
+    _stripeCount = std::clamp<std::size_t>(stripeCount, 1, MAX_STRIPES);
+    _stripes = std::make_unique<Stripe[]>(_stripeCount);
+}
+
+Glicko2RatingIndex::~Glicko2RatingIndex() = default;
+
+uint64_t Glicko2RatingIndex::Mix(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+void Glicko2RatingIndex::Store(Slot& slot, uint64_t key, Glicko2RatingSnapshot const& snapshot)
+{
+    slot.words[0].store(std::bit_cast<uint32_t>(snapshot.rating), std::memory_order_relaxed);
+    slot.words[1].store(std::bit_cast<uint32_t>(snapshot.ratingDeviation), std::memory_order_relaxed);
+    slot.words[2].store(std::bit_cast<uint32_t>(snapshot.volatility), std::memory_order_relaxed);
+    slot.words[3].store(snapshot.lastMatchTime, std::memory_order_relaxed);
+    slot.key.store(key, std::memory_order_relaxed);
+}
+
+Glicko2RatingSnapshot Glicko2RatingIndex::Load(Slot const& slot)
+{
+    Glicko2RatingSnapshot snapshot;
+    snapshot.rating = std::bit_cast<float>(slot.words[0].load(std::memory_order_relaxed));
+    snapshot.ratingDeviation = std::bit_cast<float>(slot.words[1].load(std::memory_order_relaxed));
+    snapshot.volatility = std::bit_cast<float>(slot.words[2].load(std::memory_order_relaxed));
+    snapshot.lastMatchTime = slot.words[3].load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+Glicko2RatingIndex::Slot* Glicko2RatingIndex::Probe(Table& table, uint64_t hash, uint64_t key)
+{
+    Slot* freeSlot = nullptr;
+    std::size_t pos = (hash >> 16) & table.mask;
+
+    for (std::size_t i = 0; i <= table.mask; ++i, pos = (pos + 1) & table.mask)
+    {
+        Slot& slot = table.slots[pos];
+        uint64_t slotKey = slot.key.load(std::memory_order_relaxed);
+
+        if (slotKey == key)
+            return &slot;
+
+        if (slotKey == TOMBSTONE_KEY)
+        {
+            if (!freeSlot)
+                freeSlot = &slot;
+        }
+        else if (slotKey == EMPTY_KEY)
+            return freeSlot ? freeSlot : &slot;
+    }
+
+    return freeSlot;
+}
+
+bool Glicko2RatingIndex::Find(uint64_t key, Glicko2RatingSnapshot& snapshot) const
+{
+    uint64_t hash = Mix(key);
+    Stripe const& stripe = GetStripe(hash);
+
+    for (;;)
+    {
+        uint32_t sequence = stripe.sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+            continue;
+
+        bool found = false;
+        Glicko2RatingSnapshot candidate;
+
+        if (Table const* table = stripe.table.load(std::memory_order_acquire))
+        {
+            std::size_t pos = (hash >> 16) & table->mask;
+            for (std::size_t i = 0; i <= table->mask; ++i, pos = (pos + 1) & table->mask)
+            {
+                Slot const& slot = table->slots[pos];
+                uint64_t slotKey = slot.key.load(std::memory_order_relaxed);
+                if (slotKey == EMPTY_KEY)
+                    break;
+
+                if (slotKey == key)
+                {
+                    candidate = Load(slot);
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (stripe.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        if (found)
+            snapshot = candidate;
+
+        return found;
+    }
+}
+
+void Glicko2RatingIndex::Reserve(Stripe& stripe)
+{
+    std::size_t capacity = stripe.current ? stripe.current->mask + 1 : 0;
+
+    // Keep live keys and tombstones under 3/4 of the table so probes stay short
+    if ((stripe.used + 1) * 4 <= capacity * 3)
+        return;
+
+    std::size_t newCapacity = std::max(capacity, MIN_CAPACITY);
+    while ((stripe.size + 1) * 2 > newCapacity)
+        newCapacity *= 2;
+
+    if (newCapacity == capacity)
+    {
+        // Mostly tombstones: rebuild in place, readers retry until it is done
+        std::vector<std::pair<uint64_t, Glicko2RatingSnapshot>> live;
+        live.reserve(stripe.size);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            Slot const& slot = stripe.current->slots[i];
+            uint64_t key = slot.key.load(std::memory_order_relaxed);
+            if (key == EMPTY_KEY || key == TOMBSTONE_KEY)
+                continue;
+
+            live.emplace_back(key, Load(slot));
+        }
+
+        uint32_t sequence = BeginWrite(stripe.sequence);
+        for (std::size_t i = 0; i < capacity; ++i)
+            stripe.current->slots[i].key.store(EMPTY_KEY, std::memory_order_relaxed);
+
+        for (auto const& [key, snapshot] : live)
+            Store(*Probe(*stripe.current, Mix(key), key), key, snapshot);
+
+        EndWrite(stripe.sequence, sequence);
+        stripe.used = stripe.size;
+        return;
+    }
+
+    // Grow: fill a table readers cannot see yet, then publish it
+    auto table = std::make_unique<Table>();
+    table->mask = newCapacity - 1;
+    table->slots = std::make_unique<Slot[]>(newCapacity);
+
+    if (stripe.current)
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            Slot const& slot = stripe.current->slots[i];
+            uint64_t key = slot.key.load(std::memory_order_relaxed);
+            if (key == EMPTY_KEY || key == TOMBSTONE_KEY)
+                continue;
+
+            Store(*Probe(*table, Mix(key), key), key, Load(slot));
+        }
+
+        stripe.retired.push_back(std::move(stripe.current));
+    }
+
+    stripe.current = std::move(table);
+    stripe.table.store(stripe.current.get(), std::memory_order_release);
+    stripe.used = stripe.size;
+}
+
+void Glicko2RatingIndex::Publish(uint64_t key, Glicko2RatingSnapshot const& snapshot)
+{
+    assert(key != EMPTY_KEY && key != TOMBSTONE_KEY);
+
+    uint64_t hash = Mix(key);
+    Stripe& stripe = GetStripe(hash);
+    std::lock_guard guard(stripe.writeLock);
+
+    Reserve(stripe);
+
+    Slot* slot = Probe(*stripe.current, hash, key);
+    uint64_t slotKey = slot->key.load(std::memory_order_relaxed);
+
+    uint32_t sequence = BeginWrite(stripe.sequence);
+    Store(*slot, key, snapshot);
+    EndWrite(stripe.sequence, sequence);
+
+    if (slotKey != key)
+    {
+        ++stripe.size;
+        if (slotKey == EMPTY_KEY)
+            ++stripe.used;
+    }
+}
+
+void Glicko2RatingIndex::Remove(uint64_t key)
+{
+    uint64_t hash = Mix(key);
+    Stripe& stripe = GetStripe(hash);
+    std::lock_guard guard(stripe.writeLock);
+
+    if (!stripe.current)
+        return;
+
+    Slot* slot = Probe(*stripe.current, hash, key);
+    if (!slot || slot->key.load(std::memory_order_relaxed) != key)
+        return;
+
+    uint32_t sequence = BeginWrite(stripe.sequence);
+    slot->key.store(TOMBSTONE_KEY, std::memory_order_relaxed);
+    EndWrite(stripe.sequence, sequence);
+
+    --stripe.size;
+}
+
+void Glicko2RatingIndex::Clear()
+{
+    for (std::size_t i = 0; i < _stripeCount; ++i)
+    {
+        Stripe& stripe = _stripes[i];
+        std::lock_guard guard(stripe.writeLock);
+
+        if (!stripe.current)
+            continue;
+
+        uint32_t sequence = BeginWrite(stripe.sequence);
+        for (std::size_t slot = 0; slot <= stripe.current->mask; ++slot)
+            stripe.current->slots[slot].key.store(EMPTY_KEY, std::memory_order_relaxed);
+        EndWrite(stripe.sequence, sequence);
+
+        stripe.size = 0;
+        stripe.used = 0;
+    }
+}
+
+std::size_t Glicko2RatingIndex::Size() const
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < _stripeCount; ++i)
+    {
+        std::lock_guard guard(_stripes[i].writeLock);
+        size += _stripes[i].size;
+    }
+
+    return size;
+}
+
+void Glicko2RatingIndex::Resize(std::size_t stripeCount)
+{
+    stripeCount = std::clamp<std::size_t>(stripeCount, 1, MAX_STRIPES);
+    if (stripeCount == _stripeCount)
+        return;
+
+    std::unique_ptr<Stripe[]> oldStripes = std::move(_stripes);
+    std::size_t oldCount = _stripeCount;
+
+    _stripeCount = stripeCount;
+    _stripes = std::make_unique<Stripe[]>(_stripeCount);
+
+    for (std::size_t i = 0; i < oldCount; ++i)
+    {
+        Table const* table = oldStripes[i].current.get();
+        if (!table)
+            continue;
+
+        for (std::size_t slot = 0; slot <= table->mask; ++slot)
+        {
+            uint64_t key = table->slots[slot].key.load(std::memory_order_relaxed);
+            if (key == EMPTY_KEY || key == TOMBSTONE_KEY)
+                continue;
+
+            Publish(key, Load(table->slots[slot]));
+        }
+    }
+}
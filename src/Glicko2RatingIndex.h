@@ -0,0 +1,148 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_RATING_INDEX_H
+#define _GLICKO2_RATING_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief The fields matchmaking reads: rating, RD and what inactivity decay needs
+struct Glicko2RatingSnapshot
+{
+    float rating = 0.0f;
+    float ratingDeviation = 0.0f;
+    float volatility = 0.0f;
+    uint32_t lastMatchTime = 0;
+};
+
+/// @brief Rating and RD summed over a set of players, for group and pool averages
+struct Glicko2RatingSum
+{
+    float rating = 0.0f;
+    float ratingDeviation = 0.0f;
+    std::size_t count = 0;
+
+    void Add(float playerRating, float playerRatingDeviation)
+    {
+        rating += playerRating;
+        ratingDeviation += playerRatingDeviation;
+        ++count;
+    }
+
+    /// @brief Averages, or the fallback for an empty set
+    float GetAverageRating(float fallback) const { return count ? rating / static_cast<float>(count) : fallback; }
+    float GetAverageRatingDeviation(float fallback) const { return count ? ratingDeviation / static_cast<float>(count) : fallback; }
+};
+
+/**
+ * @brief Read-mostly copy of cached ratings with lock-free lookups
+ *
+ * Keys are split over stripes; each stripe is an open-addressing table
+ * guarded by a sequence lock. Find() only loads the stripe's sequence
+ * counter and the slots, never writes shared memory, so queue threads
+ * scoring groups do not bounce a lock's cache line between cores. A reader
+ * that overlaps a write to the same stripe retries.
+ *
+ * Writers are serialized per stripe by a mutex. Tables replaced by growth
+ * are kept until destruction, because a reader may still be probing them;
+ * they add up to less than the live table size. Tombstone cleanup rebuilds
+ * the table in place.
+ *
+ * Key 0 and UINT64_MAX are reserved.
+ */
+class Glicko2RatingIndex
+{
+public:
+    static constexpr std::size_t DEFAULT_STRIPES = 16;
+    static constexpr std::size_t MAX_STRIPES = 1024;
+
+    explicit Glicko2RatingIndex(std::size_t stripeCount = DEFAULT_STRIPES);
+    ~Glicko2RatingIndex();
+
+    Glicko2RatingIndex(Glicko2RatingIndex const&) = delete;
+    Glicko2RatingIndex& operator=(Glicko2RatingIndex const&) = delete;
+
+    /// @brief Lock-free lookup; false if the key is not indexed
+    bool Find(uint64_t key, Glicko2RatingSnapshot& snapshot) const;
+
+    /// @brief Inserts or overwrites the snapshot for key
+    void Publish(uint64_t key, Glicko2RatingSnapshot const& snapshot);
+
+    void Remove(uint64_t key);
+    void Clear();
+
+    std::size_t Size() const;
+    std::size_t GetStripeCount() const { return _stripeCount; }
+
+    /// @brief Redistributes every entry over a new number of stripes; not thread-safe
+    void Resize(std::size_t stripeCount);
+
+    /// @brief Bytes one indexed key occupies in a table, for memory budgets
+    static constexpr std::size_t GetSlotSize() { return sizeof(Slot); }
+
+private:
+    static constexpr uint64_t EMPTY_KEY = 0;
+    static constexpr uint64_t TOMBSTONE_KEY = UINT64_MAX;
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    /// @brief Snapshot stored as atomic words so racing reads are defined
+    struct Slot
+    {
+        std::atomic<uint64_t> key{ EMPTY_KEY };
+        std::atomic<uint32_t> words[4] = {};
+    };
+
+    struct Table
+    {
+        std::size_t mask = 0;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint32_t> sequence{ 0 };        ///< Odd while a write is in progress
+        std::atomic<Table const*> table{ nullptr }; ///< What readers probe
+
+        mutable std::mutex writeLock;
+        std::unique_ptr<Table> current;
+        std::vector<std::unique_ptr<Table>> retired;
+        std::size_t size = 0;                       ///< Live keys
+        std::size_t used = 0;                       ///< Live keys and tombstones
+    };
+
+    static uint64_t Mix(uint64_t key);
+    static void Store(Slot& slot, uint64_t key, Glicko2RatingSnapshot const& snapshot);
+    static Glicko2RatingSnapshot Load(Slot const& slot);
+
+    /// @brief Slot holding key, or the first free one on its probe path
+    static Slot* Probe(Table& table, uint64_t hash, uint64_t key);
+
+    Stripe& GetStripe(uint64_t hash) const { return _stripes[hash % _stripeCount]; }
+
+    /// @brief Makes room for one more key; called with writeLock held
+    void Reserve(Stripe& stripe);
+
+    std::unique_ptr<Stripe[]> _stripes;
+    std::size_t _stripeCount = 0;
+};
+
+#endif // _GLICKO2_RATING_INDEX_H
@@ -0,0 +1,205 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2RatingPeriod.h"
+#include "Glicko2PlayerStorage.h"
+#include "ArenaMMR.h"
+#include "BattlegroundMMR.h"
+#include "Config.h"
+#include "Log.h"
+#include <algorithm>
+#include <array>
+
+Glicko2RatingPeriodMgr* Glicko2RatingPeriodMgr::instance()
+{
+    static Glicko2RatingPeriodMgr instance;
+    return &instance;
+}
+
+void Glicko2RatingPeriodMgr::LoadConfig()
+{
+    bool enabled = sConfigMgr->GetOption<bool>("Glicko2.RatingPeriod.Enable", false);
+    uint32 periodLength = std::max<uint32>(sConfigMgr->GetOption<uint32>("Glicko2.RatingPeriod.LengthSeconds", 3600), 1);
+
+    // The match paths' settings, so a period commit rates exactly as a match would
+    {
+        std::lock_guard lock(_mutex);
+        _periodLength = periodLength;
+        _bgGlicko.SetTau(sBattlegroundMMRMgr->GetMatchTau());
+        _bgGlicko.SetSolverOptions(sBattlegroundMMRMgr->GetSolverOptions());
+        _arenaGlicko.SetTau(sArenaMMRMgr->GetSystemTau());
+        _arenaGlicko.SetSolverOptions(sArenaMMRMgr->GetSolverOptions());
+    }
+
+    // Results buffered before periods were switched off must not be lost
+    if (_enabled && !enabled)
+        CommitPeriod();
+
+    _enabled = enabled;
+
+    LOG_INFO("module.glicko2", "[Glicko2] Rating periods {} (length: {}s)",
+        _enabled ? "enabled" : "disabled", _periodLength);
+}
+
+void Glicko2RatingPeriodMgr::AddResult(ObjectGuid playerGuid, Glicko2RatingPool pool, Glicko2Opponent const& opponent)
+{
+    std::lock_guard lock(_mutex);
+    _pending[{ playerGuid, pool }].push_back(opponent);
+}
+
+void Glicko2RatingPeriodMgr::Update(uint32 diff)
+{
+    if (!_enabled)
+        return;
+
+    // 64-bit: periods of 50 days and more overflow a uint32 millisecond count
+    _timer += diff;
+    if (_timer < uint64(_periodLength) * 1000)
+        return;
+
+    _timer = 0;
+    CommitPeriod();
+}
+
+void Glicko2RatingPeriodMgr::CommitPeriod()
+{
+    PendingMap pending;
+    {
+        std::lock_guard lock(_mutex);
+        pending.swap(_pending);
+    }
+
+    if (pending.empty())
+        return;
+
+    Commit(pending);
+}
+
+void Glicko2RatingPeriodMgr::CommitPlayer(ObjectGuid playerGuid)
+{
+    PendingMap pending;
+    {
+        std::lock_guard lock(_mutex);
+        for (uint8 pool = 0; pool < static_cast<uint8>(Glicko2RatingPool::MAX_POOLS); ++pool)
+        {
+            auto itr = _pending.find({ playerGuid, static_cast<Glicko2RatingPool>(pool) });
+            if (itr == _pending.end())
+                continue;
+
+            pending.insert(_pending.extract(itr));
+        }
+    }
+
+    if (pending.empty())
+        return;
+
+    Commit(pending);
+}
+
+size_t Glicko2RatingPeriodMgr::GetPendingCount() const
+{
+    std::lock_guard lock(_mutex);
+    return _pending.size();
+}
+
+void Glicko2RatingPeriodMgr::Commit(PendingMap& pending)
+{
+    // Group players by pool; each pool becomes one CSR batch
+    std::array<std::vector<PendingMap::const_iterator>, static_cast<size_t>(Glicko2RatingPool::MAX_POOLS)> pools;
+    for (auto itr = pending.cbegin(); itr != pending.cend(); ++itr)
+        pools[static_cast<uint8>(itr->first.pool)].push_back(itr);
+
+    Glicko2System bgGlicko;
+    Glicko2System arenaGlicko;
+    {
+        std::lock_guard lock(_mutex);
+        bgGlicko = _bgGlicko;
+        arenaGlicko = _arenaGlicko;
+    }
+
+    size_t totalResults = 0;
+
+    for (uint8 pool = 0; pool < pools.size(); ++pool)
+    {
+        auto const& entries = pools[pool];
+        if (entries.empty())
+            continue;
+
+        bool battleground = pool == static_cast<uint8>(Glicko2RatingPool::BATTLEGROUND);
+        ArenaBracket bracket = static_cast<ArenaBracket>(battleground ? 0 : pool - 1);
+
+        size_t count = entries.size();
+        std::vector<ObjectGuid> guids(count);
+
+        std::vector<size_t> offsets(1, 0);
+        std::vector<float> opponentRatings;
+        std::vector<float> opponentRDs;
+        std::vector<float> scores;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            guids[i] = entries[i]->first.guid;
+
+            for (Glicko2Opponent const& opponent : entries[i]->second)
+            {
+                opponentRatings.push_back(opponent.rating);
+                opponentRDs.push_back(opponent.ratingDeviation);
+                scores.push_back(opponent.score);
+            }
+
+            offsets.push_back(scores.size());
+        }
+
+        // The pool is read, rated and written back in one critical section, so a rating set or
+        // committed meanwhile is never overwritten with one computed from stale data. Only the
+        // rating fields are written, so counters updated since the period started are kept
+        Glicko2System& glicko = battleground ? bgGlicko : arenaGlicko;
+        auto ratePool = [&](auto data)
+        {
+            std::vector<float> ratings(count);
+            std::vector<float> ratingDeviations(count);
+            std::vector<float> volatilities(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                ratings[i] = data[i].rating;
+                ratingDeviations[i] = data[i].ratingDeviation;
+                volatilities[i] = data[i].volatility;
+            }
+
+            glicko.UpdateRatingsBatch({ ratings, ratingDeviations, volatilities },
+                { offsets, opponentRatings, opponentRDs, scores });
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                data[i].rating = ratings[i];
+                data[i].ratingDeviation = ratingDeviations[i];
+                data[i].volatility = volatilities[i];
+            }
+        };
+
+        if (battleground)
+            sGlicko2Storage->Update(guids, ratePool);
+        else
+            sArenaRatingStorage->Update(guids, bracket, ratePool);
+
+        totalResults += scores.size();
+    }
+
+    LOG_DEBUG("module.glicko2", "[Glicko2] Rating period committed: {} players, {} results",
+        pending.size(), totalResults);
+}
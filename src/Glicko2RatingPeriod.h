@@ -0,0 +1,129 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLICKO2_RATING_PERIOD_H
+#define GLICKO2_RATING_PERIOD_H
+
+#include "Glicko2.h"
+#include "ArenaRatingStorage.h"
+#include "ObjectGuid.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Rating tables a pending result can belong to
+enum class Glicko2RatingPool : uint8
+{
+    BATTLEGROUND = 0,   ///< character_battleground_rating
+    ARENA_2v2    = 1,   ///< character_arena_stats slot 0
+    ARENA_3v3    = 2,   ///< character_arena_stats slot 1
+    ARENA_5v5    = 3,   ///< character_arena_stats slot 2
+
+    MAX_POOLS    = 4
+};
+
+/// @brief Rating pool holding a player's results for an arena bracket
+inline Glicko2RatingPool GetArenaRatingPool(ArenaBracket bracket)
+{
+    return static_cast<Glicko2RatingPool>(static_cast<uint8>(bracket) + 1);
+}
+
+/**
+ * @brief Accumulates match results into true Glicko-2 rating periods
+ *
+ * With rating periods enabled, match ends only record the averaged opposing
+ * team into a per-player buffer. When the period ends (driven by the world
+ * timer) every player with results gets a single multi-opponent update, so
+ * the volatility solve runs once per player per period instead of once per
+ * match, off the match-end path. Win/loss counters are still updated when the
+ * match ends.
+ */
+class Glicko2RatingPeriodMgr
+{
+public:
+    static Glicko2RatingPeriodMgr* instance();
+
+    /// Load configuration from worldserver.conf
+    void LoadConfig();
+
+    /// Whether match results are deferred to the end of the rating period
+    bool IsEnabled() const { return _enabled; }
+
+    /// Rating period length in seconds
+    uint32 GetPeriodLength() const { return _periodLength; }
+
+    /// Buffer one result until the period ends
+    void AddResult(ObjectGuid playerGuid, Glicko2RatingPool pool, Glicko2Opponent const& opponent);
+
+    /// Advance the period timer, committing all pending results at the boundary
+    void Update(uint32 diff);
+
+    /// Apply every pending result now and start a new period
+    void CommitPeriod();
+
+    /// Apply one player's pending results now (e.g. before their rating is saved on logout)
+    void CommitPlayer(ObjectGuid playerGuid);
+
+    /// Number of player/pool entries with pending results
+    size_t GetPendingCount() const;
+
+private:
+    Glicko2RatingPeriodMgr() = default;
+    ~Glicko2RatingPeriodMgr() = default;
+
+    Glicko2RatingPeriodMgr(Glicko2RatingPeriodMgr const&) = delete;
+    Glicko2RatingPeriodMgr& operator=(Glicko2RatingPeriodMgr const&) = delete;
+
+    struct PendingKey
+    {
+        ObjectGuid guid;
+        Glicko2RatingPool pool;
+
+        bool operator==(PendingKey const& other) const
+        {
+            return guid == other.guid && pool == other.pool;
+        }
+    };
+
+    struct PendingKeyHash
+    {
+        size_t operator()(PendingKey const& key) const
+        {
+            return std::hash<uint64>()(key.guid.GetRawValue()) ^
+                   (std::hash<uint8>()(static_cast<uint8>(key.pool)) << 1);
+        }
+    };
+
+    using PendingMap = std::unordered_map<PendingKey, std::vector<Glicko2Opponent>, PendingKeyHash>;
+
+    /// Run one batched update per pool and write the new ratings back to storage
+    void Commit(PendingMap& pending);
+
+    bool _enabled = false;
+    uint32 _periodLength = 3600;
+    uint64 _timer = 0;              ///< Milliseconds elapsed in the current period
+
+    PendingMap _pending;
+    mutable std::mutex _mutex;
+
+    Glicko2System _bgGlicko;        ///< Battleground tau and solver settings
+    Glicko2System _arenaGlicko;     ///< Arena tau and solver settings
+};
+
+#define sGlicko2RatingPeriodMgr Glicko2RatingPeriodMgr::instance()
+
+#endif // GLICKO2_RATING_PERIOD_H
@@ -0,0 +1,312 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_SHARDED_CACHE_H
+#define _GLICKO2_SHARDED_CACHE_H
+
+#include "Glicko2FlatMap.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+/// @brief Lookup and eviction counters summed over every shard
+struct Glicko2CacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t capacity = 0;       ///< Entry limit, 0 when unbounded
+    std::size_t memoryUsage = 0;    ///< Bytes held by the shards' slot arrays
+};
+
+/**
+ * @brief Flat hash map split into independently locked shards
+ *
+ * A key always lives in the shard picked by its (remixed) value, so writers
+ * on different players only contend when they land on the same shard
+ * instead of serializing on one storage-wide lock. Callers take the shard
+ * lock themselves, which lets them keep related state (dirty versions,
+ * pending loads) consistent under the same stripe.
+ *
+ * With a capacity set, each shard keeps at most its share of it. Callers
+ * check IsFull() before inserting and Evict() drops the entries least
+ * recently stamped by Touch() that the caller allows to go (the storages
+ * keep dirty and online players), down to 7/8 of the share. A shard whose
+ * remaining entries are all pinned stays over its share and is not
+ * scanned again until it has grown by another 1/8.
+ *
+ * Not thread-safe against Resize(); the storages only resize while loading
+ * their configuration at startup.
+ */
+template <typename Key, typename Value>
+class Glicko2ShardedCache
+{
+public:
+    static constexpr std::size_t DEFAULT_SHARDS = 16;
+    static constexpr std::size_t MAX_SHARDS = 1024;
+
+    using Map = Glicko2FlatMap<Key, Value>;
+
+    /// @brief One stripe; aligned so neighbouring locks do not share a cache line
+    struct alignas(64) Shard
+    {
+        Map map;
+        mutable std::shared_mutex mutex;
+
+        mutable std::atomic<uint32_t> clock{ 0 };       ///< Source of Touch() stamps
+        mutable std::atomic<uint64_t> hits{ 0 };
+        mutable std::atomic<uint64_t> misses{ 0 };
+        std::atomic<uint64_t> evictions{ 0 };
+        std::size_t evictAt = 0;                        ///< Size that triggers the next Evict(); under the unique lock
+    };
+
+    explicit Glicko2ShardedCache(std::size_t shardCount = DEFAULT_SHARDS)
+    {
+        _shardCount = std::clamp<std::size_t>(shardCount, 1, MAX_SHARDS);
+        _shards = std::make_unique<Shard[]>(_shardCount);
+    }
+
+    Shard& GetShard(Key const& key) { return _shards[GetShardIndex(key)]; }
+    Shard const& GetShard(Key const& key) const { return _shards[GetShardIndex(key)]; }
+
+    std::size_t GetShardCount() const { return _shardCount; }
+
+    std::size_t GetShardIndex(Key const& key) const
+    {
+        // Keys are GUID counters; remix so consecutive characters spread
+        // over every shard regardless of the shard count
+        uint64_t hash = static_cast<uint64_t>(key);
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return static_cast<std::size_t>(hash % _shardCount);
+    }
+
+    /**
+     * @brief Unique locks on every shard holding one of the keys
+     *
+     * Each shard is locked once, in ascending shard order, so two batches
+     * over overlapping keys cannot deadlock. The locks are released when the
+     * returned vector is destroyed.
+     */
+    std::vector<std::unique_lock<std::shared_mutex>> LockShards(std::span<Key const> keys)
+    {
+        std::vector<std::size_t> indices;
+        indices.reserve(keys.size());
+        for (Key const& key : keys)
+            indices.push_back(GetShardIndex(key));
+
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+        locks.reserve(indices.size());
+        for (std::size_t index : indices)
+            locks.emplace_back(_shards[index].mutex);
+
+        return locks;
+    }
+
+    /**
+     * @brief Shared locks on every shard, in the same ascending order as LockShards()
+     *
+     * While they are held no LockShards() batch can be half applied, so a
+     * copy taken under them is one consistent snapshot. Every writer waits
+     * meanwhile: copy out and release.
+     */
+    std::vector<std::shared_lock<std::shared_mutex>> LockAllShared() const
+    {
+        std::vector<std::shared_lock<std::shared_mutex>> locks;
+        locks.reserve(_shardCount);
+        for (std::size_t i = 0; i < _shardCount; ++i)
+            locks.emplace_back(_shards[i].mutex);
+
+        return locks;
+    }
+
+    /// @brief Marks an entry most recently used; the shard lock may be held shared
+    static void Touch(Shard const& shard, uint32_t& lastAccess)
+    {
+        uint32_t stamp = shard.clock.fetch_add(1, std::memory_order_relaxed) + 1;
+        std::atomic_ref<uint32_t>(lastAccess).store(stamp, std::memory_order_relaxed);
+    }
+
+    /// @brief Counts a lookup for GetStats()
+    static void RecordLookup(Shard const& shard, bool hit)
+    {
+        (hit ? shard.hits : shard.misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Total entry limit spread evenly over the shards; 0 removes the limit
+    void SetCapacity(std::size_t entries)
+    {
+        _shardCapacity.store(entries ? std::max<std::size_t>((entries + _shardCount - 1) / _shardCount, 1) : 0,
+            std::memory_order_relaxed);
+
+        ForEachShard([](Shard& shard)
+        {
+            std::unique_lock lock(shard.mutex);
+            shard.evictAt = 0;
+        });
+    }
+
+    std::size_t GetCapacity() const { return _shardCapacity.load(std::memory_order_relaxed) * _shardCount; }
+
+    /// @brief Whether inserting a new key should be preceded by Evict(); call under the unique lock
+    bool IsFull(Shard const& shard) const
+    {
+        std::size_t capacity = _shardCapacity.load(std::memory_order_relaxed);
+        return capacity && shard.map.size() >= std::max(capacity, shard.evictAt);
+    }
+
+    /**
+     * @brief Drops least recently used entries until the shard is at 7/8 of its share (at least one below it)
+     *
+     * Called under the shard's unique lock. canEvict(key, value) pins entries
+     * that must stay; onEvict(key, value) runs just before each erase. Value
+     * must have a uint32_t lastAccess member stamped with Touch().
+     *
+     * @return Number of entries evicted
+     */
+    template <typename CanEvict, typename OnEvict>
+    std::size_t Evict(Shard& shard, CanEvict&& canEvict, OnEvict&& onEvict)
+    {
+        std::size_t capacity = _shardCapacity.load(std::memory_order_relaxed);
+        if (!capacity)
+            return 0;
+
+        std::size_t slack = std::max<std::size_t>(capacity / 8, 1);
+        std::size_t target = capacity - slack;
+        std::size_t excess = shard.map.size() > target ? shard.map.size() - target : 0;
+
+        // Age against the shard clock, so stamps wrapping around still order correctly
+        uint32_t now = shard.clock.load(std::memory_order_relaxed);
+        std::vector<std::pair<uint32_t, Key>> candidates;
+        for (auto const& [key, value] : shard.map)
+            if (canEvict(key, value))
+                candidates.emplace_back(now - value.lastAccess, key);
+
+        std::size_t count = std::min(excess, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+            [](auto const& left, auto const& right) { return left.first > right.first; });
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto itr = shard.map.find(candidates[i].second);
+            onEvict(itr->first, itr->second);
+            shard.map.erase(itr->first);
+        }
+
+        // Pinned entries left the shard over its share: rescan only after another 1/8 of growth
+        shard.evictAt = std::max(capacity, shard.map.size() + slack);
+        shard.evictions.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    /// @brief Counters and sizes summed over every shard
+    Glicko2CacheStats GetStats() const
+    {
+        Glicko2CacheStats stats;
+        stats.capacity = GetCapacity();
+
+        ForEachShard([&stats](Shard const& shard)
+        {
+            std::shared_lock lock(shard.mutex);
+            stats.hits += shard.hits.load(std::memory_order_relaxed);
+            stats.misses += shard.misses.load(std::memory_order_relaxed);
+            stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+            stats.entries += shard.map.size();
+            stats.memoryUsage += shard.map.GetMemoryUsage();
+        });
+
+        return stats;
+    }
+
+    /// @brief Calls fn(shard) for every shard; fn takes the lock it needs
+    template <typename Function>
+    void ForEachShard(Function&& fn)
+    {
+        for (std::size_t i = 0; i < _shardCount; ++i)
+            fn(_shards[i]);
+    }
+
+    template <typename Function>
+    void ForEachShard(Function&& fn) const
+    {
+        for (std::size_t i = 0; i < _shardCount; ++i)
+            fn(static_cast<Shard const&>(_shards[i]));
+    }
+
+    /// @brief Total entries (each shard is counted under its own shared lock)
+    std::size_t Size() const
+    {
+        std::size_t size = 0;
+        ForEachShard([&size](Shard const& shard)
+        {
+            std::shared_lock lock(shard.mutex);
+            size += shard.map.size();
+        });
+
+        return size;
+    }
+
+    void Clear()
+    {
+        ForEachShard([](Shard& shard)
+        {
+            std::unique_lock lock(shard.mutex);
+            shard.map.clear();
+        });
+    }
+
+    /// @brief Redistributes every entry over a new number of shards
+    void Resize(std::size_t shardCount)
+    {
+        shardCount = std::clamp<std::size_t>(shardCount, 1, MAX_SHARDS);
+        if (shardCount == _shardCount)
+            return;
+
+        std::unique_ptr<Shard[]> oldShards = std::move(_shards);
+        std::size_t oldCount = _shardCount;
+        std::size_t capacity = GetCapacity();
+
+        _shardCount = shardCount;
+        _shards = std::make_unique<Shard[]>(_shardCount);
+
+        for (std::size_t i = 0; i < oldCount; ++i)
+            for (auto& [key, value] : oldShards[i].map)
+                GetShard(key).map.emplace(key, std::move(value));
+
+        if (capacity)
+            _shardCapacity.store(std::max<std::size_t>((capacity + _shardCount - 1) / _shardCount, 1), std::memory_order_relaxed);
+    }
+
+private:
+    std::unique_ptr<Shard[]> _shards;
+    std::size_t _shardCount = 0;
+    std::atomic<std::size_t> _shardCapacity{ 0 };   ///< Per-shard entry limit, 0 when unbounded
+};
+
+#endif // _GLICKO2_SHARDED_CACHE_H
@@ -0,0 +1,456 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2Simd.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GLICKO2_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC exposes every intrinsic regardless of /arch, no per-function target needed
+#define GLICKO2_TARGET_AVX2
+#define GLICKO2_TARGET_AVX512
+#else
+#define GLICKO2_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define GLICKO2_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#endif
+#endif
+
+namespace
+{
+    // Must match Glicko2System::SCALE_FACTOR and Glicko2System::PI_SQUARED
+    constexpr float SCALE_FACTOR = 173.7178f;
+    constexpr float PI_SQUARED = 9.8696044f;
+
+    // Cephes expf range reduction and minimax polynomial
+    constexpr float EXP_HI = 88.3762626647949f;
+    constexpr float EXP_LO = -87.3365478515625f;
+    constexpr float LOG2E = 1.44269504088896341f;
+    constexpr float LN2_HI = 0.693359375f;
+    constexpr float LN2_LO = -2.12194440e-4f;
+    constexpr float EXP_P0 = 1.9875691500e-4f;
+    constexpr float EXP_P1 = 1.3981999507e-3f;
+    constexpr float EXP_P2 = 8.3334519073e-3f;
+    constexpr float EXP_P3 = 4.1665795894e-2f;
+    constexpr float EXP_P4 = 1.6666665459e-1f;
+    constexpr float EXP_P5 = 5.0000001201e-1f;
+
+    std::atomic<Glicko2Simd::Isa>& ActiveIsa()
+    {
+        static std::atomic<Glicko2Simd::Isa> isa{ Glicko2Simd::DetectIsa() };
+        return isa;
+    }
+
+#ifdef GLICKO2_SIMD_X86
+    GLICKO2_TARGET_AVX2 inline __m256 Exp8(__m256 x)
+    {
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_LO)), _mm256_set1_ps(EXP_HI));
+
+        // exp(x) = 2^n * exp(r), n = round(x / ln2)
+        __m256 fx = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(LOG2E), _mm256_set1_ps(0.5f)));
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(LN2_HI), x);
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(LN2_LO), x);
+
+        __m256 y = _mm256_set1_ps(EXP_P0);
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P1));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P2));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P3));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P4));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P5));
+        y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+        __m256i n = _mm256_add_epi32(_mm256_cvtps_epi32(fx), _mm256_set1_epi32(127));
+        return _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(n, 23)));
+    }
+
+    /// rsqrt estimate refined with one Newton step: y' = y (1.5 - 0.5 a y²)
+    GLICKO2_TARGET_AVX2 inline __m256 RSqrt8(__m256 a)
+    {
+        __m256 y = _mm256_rsqrt_ps(a);
+        __m256 halfA = _mm256_mul_ps(a, _mm256_set1_ps(0.5f));
+        return _mm256_mul_ps(y, _mm256_fnmadd_ps(_mm256_mul_ps(halfA, y), y, _mm256_set1_ps(1.5f)));
+    }
+
+    GLICKO2_TARGET_AVX2 inline float HorizontalSum8(__m256 v)
+    {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+        return _mm_cvtss_f32(sum);
+    }
+
+    GLICKO2_TARGET_AVX2 std::size_t AccumulateAVX2(float mu, float const* ratings, float const* rds, float const* scores,
+                                                   std::size_t stride, std::size_t count, float& varianceSum, float& deltaSum)
+    {
+        constexpr std::size_t LANES = 8;
+        std::size_t blocks = count - count % LANES;
+
+        __m256 const vMu = _mm256_set1_ps(mu);
+        __m256 const vBase = _mm256_set1_ps(1500.0f);
+        __m256 const vScale = _mm256_set1_ps(SCALE_FACTOR);
+        __m256 const vK = _mm256_set1_ps(3.0f / PI_SQUARED);
+        __m256 const vOne = _mm256_set1_ps(1.0f);
+        __m256i const vIndex = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                  _mm256_set1_epi32(static_cast<int>(stride)));
+
+        __m256 vVariance = _mm256_setzero_ps();
+        __m256 vDelta = _mm256_setzero_ps();
+
+        for (std::size_t i = 0; i < blocks; i += LANES)
+        {
+            std::size_t base = i * stride;
+            __m256 r, rd, s;
+            if (stride == 1)
+            {
+                r = _mm256_loadu_ps(ratings + base);
+                rd = _mm256_loadu_ps(rds + base);
+                s = _mm256_loadu_ps(scores + base);
+            }
+            else
+            {
+                r = _mm256_i32gather_ps(ratings + base, vIndex, 4);
+                rd = _mm256_i32gather_ps(rds + base, vIndex, 4);
+                s = _mm256_i32gather_ps(scores + base, vIndex, 4);
+            }
+
+            __m256 muJ = _mm256_div_ps(_mm256_sub_ps(r, vBase), vScale);
+            __m256 phiJ = _mm256_div_ps(rd, vScale);
+            __m256 g = RSqrt8(_mm256_fmadd_ps(_mm256_mul_ps(phiJ, phiJ), vK, vOne));
+            __m256 ex = Exp8(_mm256_mul_ps(g, _mm256_sub_ps(muJ, vMu)));
+            __m256 e = _mm256_div_ps(vOne, _mm256_add_ps(vOne, ex));
+
+            __m256 g2 = _mm256_mul_ps(g, g);
+            vVariance = _mm256_fmadd_ps(_mm256_mul_ps(g2, e), _mm256_sub_ps(vOne, e), vVariance);
+            vDelta = _mm256_fmadd_ps(g, _mm256_sub_ps(s, e), vDelta);
+        }
+
+        varianceSum = HorizontalSum8(vVariance);
+        deltaSum = HorizontalSum8(vDelta);
+        return blocks;
+    }
+
+    /// Loads 8 entries that are contiguous (stride 1), broadcast (stride 0) or strided
+    GLICKO2_TARGET_AVX2 inline __m256 Load8(float const* data, std::size_t stride, __m256i index)
+    {
+        if (stride == 1)
+            return _mm256_loadu_ps(data);
+
+        if (stride == 0)
+            return _mm256_set1_ps(*data);
+
+        return _mm256_i32gather_ps(data, index, 4);
+    }
+
+    GLICKO2_TARGET_AVX2 std::size_t PredictAVX2(float const* ratingsA, float const* rdsA, std::size_t strideA,
+                                                float const* ratingsB, float const* rdsB, std::size_t strideB,
+                                                std::size_t count, float* results)
+    {
+        constexpr std::size_t LANES = 8;
+        std::size_t blocks = count - count % LANES;
+
+        __m256 const vInvScale = _mm256_set1_ps(1.0f / SCALE_FACTOR);
+        __m256 const vK = _mm256_set1_ps(3.0f / PI_SQUARED);
+        __m256 const vOne = _mm256_set1_ps(1.0f);
+        __m256i const vLane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i const vIndexA = _mm256_mullo_epi32(vLane, _mm256_set1_epi32(static_cast<int>(strideA)));
+        __m256i const vIndexB = _mm256_mullo_epi32(vLane, _mm256_set1_epi32(static_cast<int>(strideB)));
+
+        for (std::size_t i = 0; i < blocks; i += LANES)
+        {
+            __m256 rA = Load8(ratingsA + i * strideA, strideA, vIndexA);
+            __m256 rdA = Load8(rdsA + i * strideA, strideA, vIndexA);
+            __m256 rB = Load8(ratingsB + i * strideB, strideB, vIndexB);
+            __m256 rdB = Load8(rdsB + i * strideB, strideB, vIndexB);
+
+            // Ratings share the 1500 offset, so μA - μB = (rA - rB) / scale
+            __m256 muDiff = _mm256_mul_ps(_mm256_sub_ps(rA, rB), vInvScale);
+            __m256 phiA = _mm256_mul_ps(rdA, vInvScale);
+            __m256 phiB = _mm256_mul_ps(rdB, vInvScale);
+            __m256 phiSquared = _mm256_fmadd_ps(phiA, phiA, _mm256_mul_ps(phiB, phiB));
+            __m256 g = RSqrt8(_mm256_fmadd_ps(phiSquared, vK, vOne));
+            __m256 ex = Exp8(_mm256_mul_ps(g, _mm256_sub_ps(_mm256_setzero_ps(), muDiff)));
+            _mm256_storeu_ps(results + i, _mm256_div_ps(vOne, _mm256_add_ps(vOne, ex)));
+        }
+
+        return blocks;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+    // GCC 12 flags the _mm512_undefined_* placeholders inside its own AVX-512 headers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+    GLICKO2_TARGET_AVX512 inline __m512 Exp16(__m512 x)
+    {
+        x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(EXP_LO)), _mm512_set1_ps(EXP_HI));
+
+        __m512 fx = _mm512_roundscale_ps(_mm512_fmadd_ps(x, _mm512_set1_ps(LOG2E), _mm512_set1_ps(0.5f)),
+                                         _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(LN2_HI), x);
+        x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(LN2_LO), x);
+
+        __m512 y = _mm512_set1_ps(EXP_P0);
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P1));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P2));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P3));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P4));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P5));
+        y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), _mm512_add_ps(x, _mm512_set1_ps(1.0f)));
+
+        __m512i n = _mm512_add_epi32(_mm512_cvtps_epi32(fx), _mm512_set1_epi32(127));
+        return _mm512_mul_ps(y, _mm512_castsi512_ps(_mm512_slli_epi32(n, 23)));
+    }
+
+    GLICKO2_TARGET_AVX512 inline __m512 RSqrt16(__m512 a)
+    {
+        __m512 y = _mm512_rsqrt14_ps(a);
+        __m512 halfA = _mm512_mul_ps(a, _mm512_set1_ps(0.5f));
+        return _mm512_mul_ps(y, _mm512_fnmadd_ps(_mm512_mul_ps(halfA, y), y, _mm512_set1_ps(1.5f)));
+    }
+
+    GLICKO2_TARGET_AVX512 std::size_t AccumulateAVX512(float mu, float const* ratings, float const* rds, float const* scores,
+                                                       std::size_t stride, std::size_t count, float& varianceSum, float& deltaSum)
+    {
+        constexpr std::size_t LANES = 16;
+        std::size_t blocks = count - count % LANES;
+
+        __m512 const vMu = _mm512_set1_ps(mu);
+        __m512 const vBase = _mm512_set1_ps(1500.0f);
+        __m512 const vScale = _mm512_set1_ps(SCALE_FACTOR);
+        __m512 const vK = _mm512_set1_ps(3.0f / PI_SQUARED);
+        __m512 const vOne = _mm512_set1_ps(1.0f);
+        __m512i const vIndex = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32(static_cast<int>(stride)));
+
+        __m512 vVariance = _mm512_setzero_ps();
+        __m512 vDelta = _mm512_setzero_ps();
+
+        for (std::size_t i = 0; i < blocks; i += LANES)
+        {
+            std::size_t base = i * stride;
+            __m512 r, rd, s;
+            if (stride == 1)
+            {
+                r = _mm512_loadu_ps(ratings + base);
+                rd = _mm512_loadu_ps(rds + base);
+                s = _mm512_loadu_ps(scores + base);
+            }
+            else
+            {
+                r = _mm512_i32gather_ps(vIndex, ratings + base, 4);
+                rd = _mm512_i32gather_ps(vIndex, rds + base, 4);
+                s = _mm512_i32gather_ps(vIndex, scores + base, 4);
+            }
+
+            __m512 muJ = _mm512_div_ps(_mm512_sub_ps(r, vBase), vScale);
+            __m512 phiJ = _mm512_div_ps(rd, vScale);
+            __m512 g = RSqrt16(_mm512_fmadd_ps(_mm512_mul_ps(phiJ, phiJ), vK, vOne));
+            __m512 ex = Exp16(_mm512_mul_ps(g, _mm512_sub_ps(muJ, vMu)));
+            __m512 e = _mm512_div_ps(vOne, _mm512_add_ps(vOne, ex));
+
+            __m512 g2 = _mm512_mul_ps(g, g);
+            vVariance = _mm512_fmadd_ps(_mm512_mul_ps(g2, e), _mm512_sub_ps(vOne, e), vVariance);
+            vDelta = _mm512_fmadd_ps(g, _mm512_sub_ps(s, e), vDelta);
+        }
+
+        varianceSum = _mm512_reduce_add_ps(vVariance);
+        deltaSum = _mm512_reduce_add_ps(vDelta);
+        return blocks;
+    }
+
+    GLICKO2_TARGET_AVX512 inline __m512 Load16(float const* data, std::size_t stride, __m512i index)
+    {
+        if (stride == 1)
+            return _mm512_loadu_ps(data);
+
+        if (stride == 0)
+            return _mm512_set1_ps(*data);
+
+        return _mm512_i32gather_ps(index, data, 4);
+    }
+
+    GLICKO2_TARGET_AVX512 std::size_t PredictAVX512(float const* ratingsA, float const* rdsA, std::size_t strideA,
+                                                    float const* ratingsB, float const* rdsB, std::size_t strideB,
+                                                    std::size_t count, float* results)
+    {
+        constexpr std::size_t LANES = 16;
+        std::size_t blocks = count - count % LANES;
+
+        __m512 const vInvScale = _mm512_set1_ps(1.0f / SCALE_FACTOR);
+        __m512 const vK = _mm512_set1_ps(3.0f / PI_SQUARED);
+        __m512 const vOne = _mm512_set1_ps(1.0f);
+        __m512i const vLane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        __m512i const vIndexA = _mm512_mullo_epi32(vLane, _mm512_set1_epi32(static_cast<int>(strideA)));
+        __m512i const vIndexB = _mm512_mullo_epi32(vLane, _mm512_set1_epi32(static_cast<int>(strideB)));
+
+        for (std::size_t i = 0; i < blocks; i += LANES)
+        {
+            __m512 rA = Load16(ratingsA + i * strideA, strideA, vIndexA);
+            __m512 rdA = Load16(rdsA + i * strideA, strideA, vIndexA);
+            __m512 rB = Load16(ratingsB + i * strideB, strideB, vIndexB);
+            __m512 rdB = Load16(rdsB + i * strideB, strideB, vIndexB);
+
+            __m512 muDiff = _mm512_mul_ps(_mm512_sub_ps(rA, rB), vInvScale);
+            __m512 phiA = _mm512_mul_ps(rdA, vInvScale);
+            __m512 phiB = _mm512_mul_ps(rdB, vInvScale);
+            __m512 phiSquared = _mm512_fmadd_ps(phiA, phiA, _mm512_mul_ps(phiB, phiB));
+            __m512 g = RSqrt16(_mm512_fmadd_ps(phiSquared, vK, vOne));
+            __m512 ex = Exp16(_mm512_mul_ps(g, _mm512_sub_ps(_mm512_setzero_ps(), muDiff)));
+            _mm512_storeu_ps(results + i, _mm512_div_ps(vOne, _mm512_add_ps(vOne, ex)));
+        }
+
+        return blocks;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    bool CpuSupports(Glicko2Simd::Isa isa)
+    {
+        int regs[4];
+        __cpuid(regs, 0);
+        if (regs[0] < 7)
+            return false;
+
+        __cpuid(regs, 1);
+        bool osxsave = (regs[2] & (1 << 27)) != 0;
+        bool fma = (regs[2] & (1 << 12)) != 0;
+        if (!osxsave || !fma)
+            return false;
+
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+
+        if (isa == Glicko2Simd::Isa::AVX2)
+            return (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+
+        // AVX-512 additionally needs opmask and ZMM state enabled by the OS
+        return (xcr0 & 0xE6) == 0xE6 && (regs[1] & (1 << 16)) != 0;
+    }
+#else
+    bool CpuSupports(Glicko2Simd::Isa isa)
+    {
+        __builtin_cpu_init();
+
+        if (isa == Glicko2Simd::Isa::AVX2)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+#endif
+#endif // GLICKO2_SIMD_X86
+}
+
+Glicko2Simd::Isa Glicko2Simd::DetectIsa()
+{
+#ifdef GLICKO2_SIMD_X86
+    if (CpuSupports(Isa::AVX512))
+        return Isa::AVX512;
+
+    if (CpuSupports(Isa::AVX2))
+        return Isa::AVX2;
+#endif
+
+    return Isa::Scalar;
+}
+
+bool Glicko2Simd::IsIsaSupported(Isa isa)
+{
+    if (isa == Isa::Scalar)
+        return true;
+
+#ifdef GLICKO2_SIMD_X86
+    return CpuSupports(isa);
+#else
+    return false;
+#endif
+}
+
+Glicko2Simd::Isa Glicko2Simd::GetActiveIsa()
+{
+    return ActiveIsa().load(std::memory_order_relaxed);
+}
+
+bool Glicko2Simd::SetActiveIsa(Isa isa)
+{
+    if (!IsIsaSupported(isa))
+        return false;
+
+    ActiveIsa().store(isa, std::memory_order_relaxed);
+    return true;
+}
+
+char const* Glicko2Simd::GetIsaName(Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::AVX2: return "AVX2";
+        case Isa::AVX512: return "AVX-512";
+        default: return "Scalar";
+    }
+}
+
+std::size_t Glicko2Simd::AccumulateBlocks(float mu, float const* ratings, float const* rds, float const* scores,
+                                          std::size_t stride, std::size_t count, float& varianceSum, float& deltaSum)
+{
+    varianceSum = 0.0f;
+    deltaSum = 0.0f;
+
+#ifdef GLICKO2_SIMD_X86
+    switch (GetActiveIsa())
+    {
+        case Isa::AVX512:
+            return AccumulateAVX512(mu, ratings, rds, scores, stride, count, varianceSum, deltaSum);
+        case Isa::AVX2:
+            return AccumulateAVX2(mu, ratings, rds, scores, stride, count, varianceSum, deltaSum);
+        default:
+            break;
+    }
+#else
+    (void)mu; (void)ratings; (void)rds; (void)scores; (void)stride; (void)count;
+#endif
+
+    return 0;
+}
+
+std::size_t Glicko2Simd::PredictBlocks(float const* ratingsA, float const* rdsA, std::size_t strideA,
+                                       float const* ratingsB, float const* rdsB, std::size_t strideB,
+                                       std::size_t count, float* results)
+{
+#ifdef GLICKO2_SIMD_X86
+    switch (GetActiveIsa())
+    {
+        case Isa::AVX512:
+            return PredictAVX512(ratingsA, rdsA, strideA, ratingsB, rdsB, strideB, count, results);
+        case Isa::AVX2:
+            return PredictAVX2(ratingsA, rdsA, strideA, ratingsB, rdsB, strideB, count, results);
+        default:
+            break;
+    }
+#else
+    (void)ratingsA; (void)rdsA; (void)strideA; (void)ratingsB; (void)rdsB; (void)strideB; (void)count; (void)results;
+#endif
+
+    return 0;
+}
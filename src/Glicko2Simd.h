@@ -0,0 +1,104 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_SIMD_H
+#define _GLICKO2_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Vectorized g(φ)/E(μ) evaluation for the Glicko-2 opponent kernel
+ *
+ * The AVX2 kernel evaluates 8 opponents per instruction and the AVX-512
+ * kernel 16, using a polynomial exp and rsqrt with one Newton step. The
+ * instruction set is picked from CPUID when the module is loaded; hosts
+ * without AVX2 keep using the scalar code in Glicko2System.
+ *
+ * Accuracy: per-opponent terms stay within a few float ULP of the scalar
+ * path. Only the summation order differs, so a full UpdateRating() agrees
+ * with the scalar result to within 0.01 rating/RD points and 1e-5 volatility
+ * (see Glicko2SimdTest).
+ */
+namespace Glicko2Simd
+{
+    /// @brief Instruction sets the opponent kernel can run on
+    enum class Isa : uint8_t
+    {
+        Scalar = 0,
+        AVX2   = 1,
+        AVX512 = 2
+    };
+
+    /// @brief Returns the instruction set used by the opponent kernel
+    Isa GetActiveIsa();
+
+    /// @brief Returns the best instruction set reported by CPUID
+    Isa DetectIsa();
+
+    /// @brief Checks whether this host can run a given instruction set
+    bool IsIsaSupported(Isa isa);
+
+    /**
+     * @brief Overrides the instruction set picked at startup
+     * @return False (and no change) if the host does not support it
+     *
+     * Intended for differential tests and benchmarks.
+     */
+    bool SetActiveIsa(Isa isa);
+
+    /// @brief Display name of an instruction set
+    char const* GetIsaName(Isa isa);
+
+    /**
+     * @brief Accumulates the opponent sums over whole vector blocks
+     * @param mu Player's rating on Glicko-2 scale
+     * @param ratings First opponent rating (original scale)
+     * @param rds First opponent rating deviation (original scale)
+     * @param scores First match score
+     * @param stride Distance in floats between consecutive opponents
+     *               (1 for structure-of-arrays, 3 for Glicko2Opponent arrays)
+     * @param count Number of opponents available
+     * @param varianceSum Receives Σ g(φj)² E (1 - E) over the processed opponents
+     * @param deltaSum Receives Σ g(φj) (sj - E) over the processed opponents
+     * @return Number of opponents processed; the caller handles the remainder
+     *
+     * Returns 0 when the active instruction set is Scalar.
+     */
+    std::size_t AccumulateBlocks(float mu, float const* ratings, float const* rds, float const* scores,
+                                 std::size_t stride, std::size_t count, float& varianceSum, float& deltaSum);
+
+    /**
+     * @brief Predicts pairings over whole vector blocks
+     * @param ratingsA First side A rating (original scale)
+     * @param rdsA First side A rating deviation (original scale)
+     * @param strideA Distance in floats between consecutive A entries (0 broadcasts one entry)
+     * @param ratingsB First side B rating (original scale)
+     * @param rdsB First side B rating deviation (original scale)
+     * @param strideB Distance in floats between consecutive B entries
+     * @param count Number of pairings available
+     * @param results Receives 1 / (1 + exp(-g(sqrt(φA² + φB²)) (μA - μB))) per processed pairing
+     * @return Number of pairings processed; the caller handles the remainder
+     *
+     * Returns 0 when the active instruction set is Scalar.
+     */
+    std::size_t PredictBlocks(float const* ratingsA, float const* rdsA, std::size_t strideA,
+                              float const* ratingsB, float const* rdsB, std::size_t strideB,
+                              std::size_t count, float* results);
+}
+
+#endif // _GLICKO2_SIMD_H
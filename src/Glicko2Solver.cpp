@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2Solver.h"
+#include <algorithm>
+
+Glicko2SolverStats* Glicko2SolverStats::instance()
+{
+    static Glicko2SolverStats instance;
+    return &instance;
+}
+
+void Glicko2SolverStats::Record(uint32_t iterations, uint32_t bracketEvaluations, bool capped)
+{
+    _iterations[std::min<std::size_t>(iterations, BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    _bracketing[std::min<std::size_t>(bracketEvaluations, BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    _calls.fetch_add(1, std::memory_order_relaxed);
+
+    if (capped)
+        _capped.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t evaluations = uint64_t(iterations) + bracketEvaluations;
+    uint64_t currentMax = _maxEvaluations.load(std::memory_order_relaxed);
+    while (evaluations > currentMax &&
+           !_maxEvaluations.compare_exchange_weak(currentMax, evaluations, std::memory_order_relaxed))
+    {
+    }
+}
+
+Glicko2SolverStats::Snapshot Glicko2SolverStats::GetSnapshot() const
+{
+    Snapshot snapshot;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        snapshot.iterations[i] = _iterations[i].load(std::memory_order_relaxed);
+        snapshot.bracketing[i] = _bracketing[i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.calls = _calls.load(std::memory_order_relaxed);
+    snapshot.capped = _capped.load(std::memory_order_relaxed);
+    snapshot.maxEvaluations = _maxEvaluations.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void Glicko2SolverStats::Reset()
+{
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        _iterations[i].store(0, std::memory_order_relaxed);
+        _bracketing[i].store(0, std::memory_order_relaxed);
+    }
+
+    _calls.store(0, std::memory_order_relaxed);
+    _capped.store(0, std::memory_order_relaxed);
+    _maxEvaluations.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_SOLVER_H
+#define _GLICKO2_SOLVER_H
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief How the step 5 volatility root is bracketed and iterated
+enum class Glicko2SolverMode : uint8_t
+{
+    Reference = 0,  ///< Glickman's bracketing (steps of τ below ln σ²), iterate until |B - A| <= ε (at most 100 iterations)
+    WarmStart = 1   ///< Bracket outward from the player's previous σ, hard iteration cap
+};
+
+/// @brief Volatility solver settings shared by the runtime and compile-time systems
+struct Glicko2SolverOptions
+{
+    Glicko2SolverMode mode = Glicko2SolverMode::Reference;
+    uint32_t maxIterations = 12;    ///< Illinois iteration cap in WarmStart mode
+};
+
+/**
+ * @brief Process-wide histogram of volatility solver work
+ *
+ * Every solve records its Illinois iteration count and bracketing cost, so
+ * GMs can spot pathological δ values (long tails) with `.bgmmr solverstats`.
+ * Counters are relaxed atomics; readers get an approximate snapshot.
+ */
+class Glicko2SolverStats
+{
+public:
+    static constexpr std::size_t BUCKETS = 32;  ///< Last bucket collects BUCKETS - 1 or more
+
+    /// @brief Point-in-time copy of the counters
+    struct Snapshot
+    {
+        std::array<uint64_t, BUCKETS> iterations{};     ///< Solves by Illinois iteration count
+        std::array<uint64_t, BUCKETS> bracketing{};     ///< Solves by f(x) evaluations spent bracketing
+        uint64_t calls = 0;                             ///< Total solves
+        uint64_t capped = 0;                            ///< Solves stopped by the iteration cap
+        uint64_t maxEvaluations = 0;                    ///< Most f(x) evaluations in a single solve
+    };
+
+    static Glicko2SolverStats* instance();
+
+    /// @brief Records one solve
+    void Record(uint32_t iterations, uint32_t bracketEvaluations, bool capped);
+
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+private:
+    Glicko2SolverStats() = default;
+
+    std::array<std::atomic<uint64_t>, BUCKETS> _iterations{};
+    std::array<std::atomic<uint64_t>, BUCKETS> _bracketing{};
+    std::atomic<uint64_t> _calls{ 0 };
+    std::atomic<uint64_t> _capped{ 0 };
+    std::atomic<uint64_t> _maxEvaluations{ 0 };
+};
+
+#define sGlicko2SolverStats Glicko2SolverStats::instance()
+
+namespace Glicko2Solver
+{
+    /**
+     * @brief Finds the new volatility σ' (step 5 of the Glicko-2 paper)
+     * @param a ln(σ²) of the player's current volatility
+     * @param deltaSquared δ²
+     * @param phiSquared φ²
+     * @param variance Estimated variance v
+     * @param tau System constant τ
+     * @param epsilon Convergence tolerance ε
+     * @param options Solver mode and iteration cap
+     * @param f Step 5 function f(x), decreasing with a single root
+     * @return σ'
+     *
+     * Header-only so Glicko2StaticSystem keeps τ and ε as compile-time
+     * constants through the whole solve.
+     */
+    template <typename Real, typename Function>
+    Real SolveVolatility(Real a, Real deltaSquared, Real phiSquared, Real variance, Real tau, Real epsilon,
+                         Glicko2SolverOptions const& options, Function&& f)
+    {
+        uint32_t evaluations = 0;
+        auto evaluate = [&](Real x)
+        {
+            ++evaluations;
+            return f(x);
+        };
+
+        Real A = a;
+        Real B;
+        Real fA;
+        Real fB;
+
+        if (options.mode == Glicko2SolverMode::WarmStart)
+        {
+            // σ rarely moves much, so the root sits close to ln σ². Step
+            // away from it on the side f points to, doubling until the sign flips.
+            fA = evaluate(A);
+            Real direction = fA > Real(0) ? Real(1) : Real(-1);
+            Real step = tau / Real(16);
+
+            B = A + direction * step;
+            fB = evaluate(B);
+            for (int k = 0; fA * fB > Real(0) && k < 100; ++k) // Safety limit
+            {
+                step *= Real(2);
+                B = A + direction * step;
+                fB = evaluate(B);
+            }
+        }
+        else
+        {
+            if (deltaSquared > phiSquared + variance)
+            {
+                B = std::log(deltaSquared - phiSquared - variance);
+            }
+            else
+            {
+                // Find B by iteration
+                int k = 1;
+                while (evaluate(a - k * tau) < Real(0))
+                {
+                    k++;
+                    if (k > 100) // Safety limit
+                        break;
+                }
+                B = a - k * tau;
+            }
+
+            fA = evaluate(A);
+            fB = evaluate(B);
+        }
+
+        uint32_t bracketEvaluations = evaluations;
+        uint32_t iterations = 0;
+        bool capped = false;
+
+        // Illinois iteration
+        while (std::abs(B - A) > epsilon)
+        {
+            // Reference mode has no configured cap, but at float precision a
+            // large δ can leave |B - A| stuck just above ε forever
+            uint32_t limit = options.mode == Glicko2SolverMode::WarmStart ? options.maxIterations : 100;
+            if (iterations >= limit) // Safety limit
+            {
+                capped = true;
+                break;
+            }
+
+            ++iterations;
+
+            Real C = A + (A - B) * fA / (fB - fA);
+            Real fC = evaluate(C);
+
+            // Once the secant step no longer moves B the root is resolved to
+            // the precision of Real; the reference loop keeps halving fA here
+            if (options.mode == Glicko2SolverMode::WarmStart && (C == B || fC == Real(0)))
+            {
+                A = C;
+                break;
+            }
+
+            if (fC * fB <= Real(0))
+            {
+                A = B;
+                fA = fB;
+            }
+            else
+            {
+                fA = fA / Real(2);
+            }
+
+            B = C;
+            fB = fC;
+        }
+
+        sGlicko2SolverStats->Record(iterations, bracketEvaluations, capped);
+
+        // When capped, B is the most recent estimate of the root
+        return std::exp((capped ? B : A) / Real(2));
+    }
+}
+
+#endif // _GLICKO2_SOLVER_H
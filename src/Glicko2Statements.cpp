@@ -0,0 +1,144 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glicko2Statements.h"
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+    /// @brief Registered SQL, indexed by Glicko2Statements
+    constexpr std::array<std::string_view, MAX_GLICKO2_STATEMENTS> STATEMENT_SQL =
+    {
+        // GLICKO2_SEL_BG_RATING
+        "SELECT rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_battleground_rating WHERE guid = ?",
+
+        // GLICKO2_REP_BG_RATING
+        "REPLACE INTO character_battleground_rating "
+        "(guid, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+
+        // GLICKO2_DEL_BG_RATING
+        "DELETE FROM character_battleground_rating WHERE guid = ?",
+
+        // GLICKO2_INS_BG_RATING_HISTORY
+        "INSERT INTO character_battleground_rating_history "
+        "(guid, rating, rating_deviation, volatility, match_time, match_result) "
+        "VALUES (?, ?, ?, ?, ?, ?)",
+
+        // GLICKO2_DEL_BG_RATING_HISTORY
+        "DELETE FROM character_battleground_rating_history WHERE guid = ?",
+
+        // GLICKO2_SEL_ARENA_RATING
+        "SELECT rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_arena_stats WHERE guid = ? AND slot = ?",
+
+        // GLICKO2_SEL_ARENA_RATINGS
+        "SELECT slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_arena_stats WHERE guid = ?",
+
+        // GLICKO2_INS_ARENA_RATING
+        "INSERT INTO character_arena_stats "
+        "(guid, slot, matchMakerRating, maxMMR, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"
+        GLICKO2_RATING_UPSERT_UPDATE,
+
+        // GLICKO2_SEL_LOGIN_RATINGS (255 = GLICKO2_BG_LOGIN_SLOT)
+        "SELECT 255 AS slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_battleground_rating WHERE guid = ? "
+        "UNION ALL "
+        "SELECT slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_arena_stats WHERE guid = ?",
+
+        // GLICKO2_SEL_PRELOAD_RANGE
+        "SELECT (SELECT COALESCE(MAX(guid), 0) FROM character_battleground_rating), "
+        "(SELECT COALESCE(MAX(guid), 0) FROM character_arena_stats)",
+
+        // GLICKO2_SEL_PRELOAD_RATINGS: recent BG rows, and every arena slot of players recent in any slot
+        "SELECT guid, 255 AS slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_battleground_rating WHERE guid BETWEEN ? AND ? AND last_match_time >= ? "
+        "UNION ALL "
+        "SELECT guid, slot, rating, rating_deviation, volatility, matches_played, matches_won, matches_lost, last_match_time "
+        "FROM character_arena_stats WHERE guid IN "
+        "(SELECT guid FROM character_arena_stats WHERE guid BETWEEN ? AND ? AND last_match_time >= ?) "
+        "ORDER BY guid",
+    };
+
+    /// to_chars would write "nan" or "inf", which MySQL reads as a column name
+    template <typename T>
+    std::string FormatFiniteReal(T value)
+    {
+        if (!std::isfinite(value))
+            return "NULL";
+
+        char buffer[32];
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+}
+
+Glicko2SqlBuilder::Glicko2SqlBuilder(Glicko2Statements index) : _index(index)
+{
+    assert(index < MAX_GLICKO2_STATEMENTS);
+}
+
+void Glicko2SqlBuilder::Bind(uint8_t index, std::string value)
+{
+    assert(index < MAX_PARAMETERS);
+    _parameters[index] = std::move(value);
+}
+
+std::string Glicko2SqlBuilder::GetSql() const
+{
+    std::string_view statement = STATEMENT_SQL[_index];
+
+    std::string sql;
+    sql.reserve(statement.size() + MAX_PARAMETERS * 16);
+
+    std::size_t parameter = 0;
+    for (char c : statement)
+    {
+        if (c != '?')
+        {
+            sql.push_back(c);
+            continue;
+        }
+
+        assert(parameter < MAX_PARAMETERS);
+        std::string const& value = _parameters[parameter++];
+        if (value.empty())
+            sql.append("NULL"); // Unbound
+        else
+            sql.append(value);
+    }
+
+    return sql;
+}
+
+std::string Glicko2SqlBuilder::FormatReal(float value)
+{
+    return FormatFiniteReal(value);
+}
+
+std::string Glicko2SqlBuilder::FormatReal(double value)
+{
+    return FormatFiniteReal(value);
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_STATEMENTS_H
+#define _GLICKO2_STATEMENTS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/// @brief Every SQL statement the module sends to the character database, as text
+enum Glicko2Statements : uint8_t
+{
+    GLICKO2_SEL_BG_RATING,            ///< guid
+    GLICKO2_REP_BG_RATING,            ///< guid, rating, RD, volatility, played, won, lost, last match
+    GLICKO2_DEL_BG_RATING,            ///< guid
+    GLICKO2_INS_BG_RATING_HISTORY,    ///< guid, rating, RD, volatility, match time, result
+    GLICKO2_DEL_BG_RATING_HISTORY,    ///< guid
+    GLICKO2_SEL_ARENA_RATING,         ///< guid, slot
+    GLICKO2_SEL_ARENA_RATINGS,        ///< guid
+    GLICKO2_INS_ARENA_RATING,         ///< guid, slot, mmr, max mmr, rating, RD, volatility, played, won, lost, last match
+    GLICKO2_SEL_LOGIN_RATINGS,        ///< guid, guid; BG row (slot GLICKO2_BG_LOGIN_SLOT) and every arena slot
+    GLICKO2_SEL_PRELOAD_RANGE,        ///< Highest guid in each rating table
+    GLICKO2_SEL_PRELOAD_RATINGS,      ///< first guid, last guid, since (BG), then again (arena); ordered by guid
+
+    MAX_GLICKO2_STATEMENTS
+};
+
+/// @brief Update clause of every rating upsert: the Glicko-2 values and counters, never the key or legacy MMR columns
+#define GLICKO2_RATING_UPSERT_UPDATE \
+    " ON DUPLICATE KEY UPDATE " \
+    "rating = VALUES(rating), " \
+    "rating_deviation = VALUES(rating_deviation), " \
+    "volatility = VALUES(volatility), " \
+    "matches_played = VALUES(matches_played), " \
+    "matches_won = VALUES(matches_won), " \
+    "matches_lost = VALUES(matches_lost), " \
+    "last_match_time = VALUES(last_match_time)"
+
+/// @brief Slot reported for character_battleground_rating rows by the login and preload queries
+constexpr uint8_t GLICKO2_BG_LOGIN_SLOT = 255;
+
+/**
+ * @brief SQL text of a registered statement with its `?` placeholders filled in
+ *
+ * Not a prepared statement: AzerothCore has no hook for modules to prepare
+ * statements on its connections, so the text is sent like any other ad-hoc
+ * query. It keeps every statement's SQL in one table and renders bound
+ * values safely (NaN and infinity become NULL). SetData() by index matches
+ * AzerothCore's PreparedStatement, so moving an entry into
+ * CharacterDatabaseStatements later only changes the DB call.
+ */
+class Glicko2SqlBuilder
+{
+public:
+    static constexpr std::size_t MAX_PARAMETERS = 12;
+
+    explicit Glicko2SqlBuilder(Glicko2Statements index);
+
+    /// @brief Binds an integer, bool or floating point parameter
+    template <typename T>
+    void SetData(uint8_t index, T value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Glicko2SqlBuilder only binds numeric parameters");
+
+        if constexpr (std::is_same_v<T, float>)
+            Bind(index, FormatReal(value));  // Shortest float text, not the widened double's
+        else if constexpr (std::is_floating_point_v<T>)
+            Bind(index, FormatReal(static_cast<double>(value)));
+        else if constexpr (std::is_same_v<T, bool>)
+            Bind(index, value ? "1" : "0");
+        else
+            Bind(index, std::to_string(value));
+    }
+
+    /// @brief SQL text with every placeholder replaced by its bound value; unbound ones become NULL
+    std::string GetSql() const;
+
+private:
+    static std::string FormatReal(float value);
+    static std::string FormatReal(double value);
+
+    void Bind(uint8_t index, std::string value);
+
+    Glicko2Statements _index;
+    std::array<std::string, MAX_PARAMETERS> _parameters;
+};
+
+#endif // _GLICKO2_STATEMENTS_H
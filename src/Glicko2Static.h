@@ -0,0 +1,272 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GLICKO2_STATIC_H
+#define _GLICKO2_STATIC_H
+
+#include "Glicko2.h"
+#include <cmath>
+#include <ratio>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief constexpr building blocks shared by Glicko2StaticSystem
+ *
+ * Everything here can be evaluated at compile time, so lookup tables and
+ * static_assert checks can be built from the same formulas the rating
+ * update uses. At run time the standard library math is used instead.
+ */
+namespace Glicko2Constexpr
+{
+    /// @brief Square root usable in constant expressions (Newton iteration)
+    template <typename Real>
+    constexpr Real Sqrt(Real x)
+    {
+        if (!std::is_constant_evaluated())
+            return std::sqrt(x);
+
+        if (x <= Real(0))
+            return Real(0);
+
+        Real guess = x < Real(1) ? Real(1) : x;
+        for (int i = 0; i < 64; ++i)
+        {
+            Real next = (guess + x / guess) / Real(2);
+            if (next == guess)
+                break;
+            guess = next;
+        }
+
+        return guess;
+    }
+
+    /// @brief Value of a std::ratio in the requested floating type
+    template <typename Ratio, typename Real>
+    constexpr Real RatioValue = static_cast<Real>(Ratio::num) / static_cast<Real>(Ratio::den);
+
+    template <typename Real> constexpr Real SCALE_FACTOR = Real(173.7178);   ///< Conversion factor between scales
+    template <typename Real> constexpr Real PI_SQUARED = Real(9.869604401089358); ///< π²
+
+    template <typename Real>
+    constexpr Real ConvertRatingToGlicko2(Real rating) { return (rating - Real(1500)) / SCALE_FACTOR<Real>; }
+
+    template <typename Real>
+    constexpr Real ConvertRDToGlicko2(Real rd) { return rd / SCALE_FACTOR<Real>; }
+
+    template <typename Real>
+    constexpr Real ConvertRatingFromGlicko2(Real mu) { return mu * SCALE_FACTOR<Real> + Real(1500); }
+
+    template <typename Real>
+    constexpr Real ConvertRDFromGlicko2(Real phi) { return phi * SCALE_FACTOR<Real>; }
+
+    /// @brief g(φ) = 1 / sqrt(1 + 3φ²/π²)
+    template <typename Real>
+    constexpr Real CalculateG(Real phi)
+    {
+        return Real(1) / Sqrt(Real(1) + (Real(3) * phi * phi) / PI_SQUARED<Real>);
+    }
+}
+
+/**
+ * @brief Glicko-2 system with τ, ε and the floating type fixed at compile time
+ * @tparam Tau System constant τ as a std::ratio (e.g. std::ratio<1, 2> for 0.5)
+ * @tparam Epsilon Convergence tolerance ε of the volatility solver as a std::ratio
+ * @tparam Real float or double
+ *
+ * Produces the same ratings as Glicko2System for the same τ, but 1/τ² and
+ * the scale constants fold into the volatility solver instead of being
+ * reloaded from members on every f(x) evaluation. The runtime class stays in
+ * use whenever τ comes from a config value other than the one compiled in.
+ *
+ * τ and ε are fixed per type; an instance only carries the volatility
+ * solver options.
+ */
+template <typename Tau = std::ratio<1, 2>, typename Epsilon = std::ratio<1, 1000000>, typename Real = float>
+class Glicko2StaticSystem
+{
+public:
+    static_assert(std::is_floating_point_v<Real>, "Glicko2StaticSystem needs a floating point type");
+
+    static constexpr Real TAU = Glicko2Constexpr::RatioValue<Tau, Real>;             ///< System constant (τ)
+    static constexpr Real EPSILON = Glicko2Constexpr::RatioValue<Epsilon, Real>;     ///< Convergence tolerance (ε)
+    static constexpr Real INV_TAU_SQUARED = Real(1) / (TAU * TAU);                    ///< 1/τ², folded
+
+    static_assert(TAU > Real(0) && TAU <= Real(2), "Glickman recommends 0.3 <= tau <= 1.2; outside (0, 2] is invalid");
+    static_assert(EPSILON > Real(0) && EPSILON < Real(0.01), "Convergence tolerance must be small and positive");
+
+    // Sanity checks on the conversion layer
+    static_assert(Glicko2Constexpr::ConvertRatingToGlicko2<Real>(Real(1500)) == Real(0), "1500 must map to mu = 0");
+    static_assert(Glicko2Constexpr::CalculateG<Real>(Real(0)) == Real(1), "g(0) must be 1");
+    static_assert(Glicko2Constexpr::CalculateG(Glicko2Constexpr::ConvertRDToGlicko2<Real>(Real(350))) <
+                  Glicko2Constexpr::CalculateG(Glicko2Constexpr::ConvertRDToGlicko2<Real>(Real(30))),
+                  "g(phi) must decrease as RD grows");
+
+    /// @brief Returns τ as a float, for comparison with config values
+    static constexpr float GetTau() { return static_cast<float>(TAU); }
+
+    /// @brief Gets the volatility solver settings
+    Glicko2SolverOptions const& GetSolverOptions() const { return _solverOptions; }
+
+    /// @brief Selects the volatility solver (reference or warm-started and capped)
+    void SetSolverOptions(Glicko2SolverOptions const& options) { _solverOptions = options; }
+
+    /// @brief Converts an opponent to the Glicko-2 scale and evaluates g(φ) once
+    static Glicko2PreparedOpponent PrepareOpponent(const Glicko2Opponent& opponent)
+    {
+        Glicko2PreparedOpponent prepared;
+        prepared.mu = static_cast<float>(Glicko2Constexpr::ConvertRatingToGlicko2<Real>(opponent.rating));
+        prepared.phi = static_cast<float>(Glicko2Constexpr::ConvertRDToGlicko2<Real>(opponent.ratingDeviation));
+        prepared.gPhi = static_cast<float>(Glicko2Constexpr::CalculateG<Real>(prepared.phi));
+        prepared.score = opponent.score;
+        return prepared;
+    }
+
+    /// @brief Updates a player's rating after a rating period (see Glicko2System::UpdateRating)
+    Glicko2Rating UpdateRating(const Glicko2Rating& playerRating, const std::vector<Glicko2Opponent>& opponents) const
+    {
+        if (opponents.empty())
+            return UpdateInactiveRating(playerRating);
+
+        Real mu = Glicko2Constexpr::ConvertRatingToGlicko2<Real>(playerRating.rating);
+        Real varianceSum = Real(0);
+        Real deltaSum = Real(0);
+
+        for (auto const& opponent : opponents)
+        {
+            Real muJ = Glicko2Constexpr::ConvertRatingToGlicko2<Real>(opponent.rating);
+            Real gPhiJ = Glicko2Constexpr::CalculateG(Glicko2Constexpr::ConvertRDToGlicko2<Real>(opponent.ratingDeviation));
+            Real e = CalculateE(mu, muJ, gPhiJ);
+
+            varianceSum += gPhiJ * gPhiJ * e * (Real(1) - e);
+            deltaSum += gPhiJ * (Real(opponent.score) - e);
+        }
+
+        return ApplyOpponentSums(playerRating, varianceSum, deltaSum);
+    }
+
+    /// @brief Updates a player's rating against prepared opponents
+    Glicko2Rating UpdateRating(const Glicko2Rating& playerRating,
+                               std::span<const Glicko2PreparedOpponent> opponents) const
+    {
+        if (opponents.empty())
+            return UpdateInactiveRating(playerRating);
+
+        Real mu = Glicko2Constexpr::ConvertRatingToGlicko2<Real>(playerRating.rating);
+        Real varianceSum = Real(0);
+        Real deltaSum = Real(0);
+
+        for (auto const& opponent : opponents)
+        {
+            Real gPhiJ = opponent.gPhi;
+            Real e = CalculateE(mu, Real(opponent.mu), gPhiJ);
+
+            varianceSum += gPhiJ * gPhiJ * e * (Real(1) - e);
+            deltaSum += gPhiJ * (Real(opponent.score) - e);
+        }
+
+        return ApplyOpponentSums(playerRating, varianceSum, deltaSum);
+    }
+
+    /// @brief Updates many players who all faced the same prepared opponent
+    void UpdateRatingsBatch(Glicko2RatingBatch players, const Glicko2PreparedOpponent& opponent) const
+    {
+        std::span<const Glicko2PreparedOpponent> opponents(&opponent, 1);
+
+        for (std::size_t i = 0; i < players.ratings.size(); ++i)
+        {
+            Glicko2Rating playerRating(players.ratings[i], players.ratingDeviations[i], players.volatilities[i]);
+            Glicko2Rating newRating = UpdateRating(playerRating, opponents);
+
+            players.ratings[i] = newRating.rating;
+            players.ratingDeviations[i] = newRating.ratingDeviation;
+            players.volatilities[i] = newRating.volatility;
+        }
+    }
+
+    /// @brief Updates rating for an inactive player (increases uncertainty)
+    static Glicko2Rating UpdateInactiveRating(const Glicko2Rating& playerRating)
+    {
+        Real phi = Glicko2Constexpr::ConvertRDToGlicko2<Real>(playerRating.ratingDeviation);
+        Real sigma = playerRating.volatility;
+
+        Glicko2Rating newRating = playerRating;
+        newRating.ratingDeviation = static_cast<float>(
+            Glicko2Constexpr::ConvertRDFromGlicko2<Real>(std::sqrt(phi * phi + sigma * sigma)));
+
+        return newRating;
+    }
+
+private:
+    static Real CalculateE(Real mu, Real muJ, Real gPhiJ)
+    {
+        return Real(1) / (Real(1) + std::exp(-gPhiJ * (mu - muJ)));
+    }
+
+    /// f(x) from step 5 of the paper, with 1/τ² folded at compile time
+    static Real VolatilityFunction(Real x, Real delta, Real phiSquared, Real variance, Real a)
+    {
+        Real ex = std::exp(x);
+        Real denominator = phiSquared + variance + ex;
+
+        Real term1 = (ex * (delta * delta - phiSquared - variance - ex)) /
+                     (Real(2) * denominator * denominator);
+        Real term2 = (x - a) * INV_TAU_SQUARED;
+
+        return term1 - term2;
+    }
+
+    Real UpdateVolatility(Real phi, Real variance, Real delta, Real sigma) const
+    {
+        Real a = std::log(sigma * sigma);
+        Real phiSquared = phi * phi;
+
+        return Glicko2Solver::SolveVolatility(a, delta * delta, phiSquared, variance, TAU, EPSILON, _solverOptions,
+            [&](Real x) { return VolatilityFunction(x, delta, phiSquared, variance, a); });
+    }
+
+    /// Steps 3-8 once the opponent sums are known
+    Glicko2Rating ApplyOpponentSums(const Glicko2Rating& playerRating, Real varianceSum, Real deltaSum) const
+    {
+        Real mu = Glicko2Constexpr::ConvertRatingToGlicko2<Real>(playerRating.rating);
+        Real phi = Glicko2Constexpr::ConvertRDToGlicko2<Real>(playerRating.ratingDeviation);
+        Real sigma = playerRating.volatility;
+
+        Real variance = varianceSum > Real(0) ? Real(1) / varianceSum : Real(0);
+        Real delta = variance * deltaSum;
+
+        Real sigmaPrime = UpdateVolatility(phi, variance, delta, sigma);
+        Real phiStar = std::sqrt(phi * phi + sigmaPrime * sigmaPrime);
+        Real phiPrime = Real(1) / std::sqrt(Real(1) / (phiStar * phiStar) + Real(1) / variance);
+        Real muPrime = mu + phiPrime * phiPrime * deltaSum;
+
+        Glicko2Rating newRating;
+        newRating.rating = static_cast<float>(Glicko2Constexpr::ConvertRatingFromGlicko2<Real>(muPrime));
+        newRating.ratingDeviation = static_cast<float>(Glicko2Constexpr::ConvertRDFromGlicko2<Real>(phiPrime));
+        newRating.volatility = static_cast<float>(sigmaPrime);
+
+        return newRating;
+    }
+
+    Glicko2SolverOptions _solverOptions;  ///< Volatility solver mode and iteration cap
+};
+
+/// Production configuration: τ = 0.5, ε = 1e-6, float (matches the Glicko2.Tau default)
+using Glicko2DefaultSystem = Glicko2StaticSystem<std::ratio<1, 2>, std::ratio<1, 1000000>, float>;
+
+#endif // _GLICKO2_STATIC_H
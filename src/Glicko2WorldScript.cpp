@@ -18,6 +18,9 @@
 #include "ScriptMgr.h"
 #include "ArenaMMR.h"
 #include "BattlegroundMMR.h"
+#include "Glicko2PlayerRatingMgr.h"
+#include "Glicko2PlayerStorage.h"
+#include "Glicko2RatingPeriod.h"
 #include "Log.h"
 
 class Glicko2WorldScript : public WorldScript
@@ -35,8 +38,47 @@ public:
         // Load arena MMR configuration
         sArenaMMRMgr->LoadConfig();
 
+        // Load rating period configuration (reads both match paths' tau and solver settings)
+        sGlicko2RatingPeriodMgr->LoadConfig();
+
+        // Warm both caches once their budgets are known
+        sGlicko2PlayerRatingMgr->LoadConfig();
+        sGlicko2PlayerRatingMgr->Preload();
+
         LOG_INFO("module", ">> Glicko-2 MMR System loaded successfully!");
     }
+
+    void OnAfterConfigLoad(bool reload) override
+    {
+        // Startup is handled by OnStartup(); cache layout settings only apply there
+        if (!reload)
+            return;
+
+        sBattlegroundMMRMgr->LoadDefaultRating();
+        sBattlegroundMMRMgr->LoadRatingOptions();
+        sArenaMMRMgr->LoadDefaultRating();
+        sArenaMMRMgr->LoadRatingOptions();
+
+        // After both match paths, whose settings it copies; switching periods off commits the open one
+        sGlicko2RatingPeriodMgr->LoadConfig();
+    }
+
+    void OnUpdate(uint32 diff) override
+    {
+        sGlicko2PlayerRatingMgr->ProcessQueryCallbacks();
+        sGlicko2RatingPeriodMgr->Update(diff);
+    }
+
+    void OnShutdown() override
+    {
+        if (!sGlicko2RatingPeriodMgr->IsEnabled())
+            return;
+
+        // Apply and persist whatever the unfinished period collected
+        sGlicko2RatingPeriodMgr->CommitPeriod();
+        sGlicko2Storage->SaveAll();
+        sArenaRatingStorage->SaveAll();
+    }
 };
 
 void AddGlicko2WorldScripts()
@@ -274,3 +274,49 @@ TEST_F(ArenaMMRTest, DisabledSystemDoesNotUpdateRatings)
 
     // Ratings should not change when disabled
 }
+
+/// Test 11: Both teams are rated against pre-match ratings
+TEST_F(ArenaMMRTest, ArenaMatchUsesPreMatchRatingsForBothTeams)
+{
+    ArenaBracket bracket = ArenaBracket::SLOT_2v2;
+
+    sArenaMMRMgr->InitializePlayerRating(player1Guid, bracket);
+    sArenaMMRMgr->InitializePlayerRating(player2Guid, bracket);
+    sArenaMMRMgr->InitializePlayerRating(player3Guid, bracket);
+    sArenaMMRMgr->InitializePlayerRating(player4Guid, bracket);
+
+    std::vector<ObjectGuid> winners = {player1Guid, player2Guid};
+    std::vector<ObjectGuid> losers = {player3Guid, player4Guid};
+
+    sArenaMMRMgr->UpdateArenaMatch(nullptr, winners, losers, bracket);
+
+    // Equal teams: the winners' gain mirrors the losers' loss
+    float gain = sArenaMMRMgr->GetPlayerRating(player1Guid, bracket) - 1500.0f;
+    float loss = 1500.0f - sArenaMMRMgr->GetPlayerRating(player3Guid, bracket);
+    EXPECT_NEAR(gain, loss, 0.01f);
+    EXPECT_FLOAT_EQ(sArenaMMRMgr->GetPlayerRatingDeviation(player1Guid, bracket),
+                    sArenaMMRMgr->GetPlayerRatingDeviation(player3Guid, bracket));
+}
+
+/// Test 12: A first match in a bracket without a row is saved once the login load completed
+TEST_F(ArenaMMRTest, FirstBracketMatchAfterLoginLoadIsSaved)
+{
+    ArenaBracket bracket = ArenaBracket::SLOT_3v3;
+    sArenaRatingStorage->SaveAll();
+
+    // Login load that found no rows for the player
+    ASSERT_TRUE(sArenaRatingStorage->BeginLoad(player1Guid));
+    sArenaRatingStorage->CompleteLoad(player1Guid);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    std::vector<ObjectGuid> winners = {player1Guid};
+    std::vector<ObjectGuid> losers = {player2Guid};
+    sArenaMMRMgr->UpdateArenaMatch(nullptr, winners, losers, bracket);
+
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 1u);
+    EXPECT_TRUE(sArenaRatingStorage->GetRating(player1Guid, bracket).loaded);
+
+    sArenaRatingStorage->SaveAll();
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+    EXPECT_GT(sArenaMMRMgr->GetPlayerRating(player1Guid, bracket), 1500.0f);
+}
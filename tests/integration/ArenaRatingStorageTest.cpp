@@ -18,6 +18,9 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "ArenaRatingStorage.h"
+#include <cmath>
+#include <thread>
+#include <vector>
 
 /// Test fixture for Arena Rating Storage tests
 /// Tests focus on cache operations and data consistency
@@ -292,3 +295,359 @@ TEST_F(ArenaRatingStorageTest, WinLossStatisticsAccumulation)
     EXPECT_EQ(final.wins, 5);
     EXPECT_EQ(final.losses, 3);
 }
+
+/// Test 13: Inactivity decay is applied per bracket on read
+TEST_F(ArenaRatingStorageTest, InactivityDecayAppliedPerBracket)
+{
+    constexpr uint32 period = 7 * 24 * 3600;
+    sArenaRatingStorage->SetInactivityDecay(period, 350.0f);
+
+    uint32 now = static_cast<uint32>(time(nullptr));
+
+    // 2v2 idle for two whole periods, 3v3 played today
+    ArenaRatingData idle(1900.0f, 50.0f, 0.05f, 40, 25, 15, ArenaBracket::SLOT_2v2);
+    idle.lastMatchTime = now - period * 2 - 60;
+    ArenaRatingData active(1700.0f, 50.0f, 0.05f, 40, 25, 15, ArenaBracket::SLOT_3v3);
+    active.lastMatchTime = now - 60;
+
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2, idle);
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3, active);
+
+    float sigmaScaled = 0.05f * 173.7178f;
+    float expectedRD = std::sqrt(50.0f * 50.0f + 2.0f * sigmaScaled * sigmaScaled);
+
+    EXPECT_NEAR(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).ratingDeviation, expectedRD, 0.01f);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3).ratingDeviation, 50.0f);
+
+    sArenaRatingStorage->SetInactivityDecay(0, 350.0f);
+}
+
+/// Test 14: Login loads fill missing brackets but never overwrite newer ones
+TEST_F(ArenaRatingStorageTest, CompleteLoadKeepsNewerRatings)
+{
+    ArenaRatingData fromMatch(1620.0f, 180.0f, 0.06f, 1, 1, 0, ArenaBracket::SLOT_3v3);
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3, fromMatch);
+
+    EXPECT_TRUE(sArenaRatingStorage->BeginLoad(player1Guid));
+    sArenaRatingStorage->CompleteLoad(player1Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(1800.0f, 60.0f, 0.05f, 120, 70, 50, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->CompleteLoad(player1Guid, ArenaBracket::SLOT_3v3,
+        ArenaRatingData(1400.0f, 90.0f, 0.06f, 40, 15, 25, ArenaBracket::SLOT_3v3));
+    sArenaRatingStorage->CompleteLoad(player1Guid);
+
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).rating, 1800.0f);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).matchesPlayed, 120u);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3).rating, 1620.0f);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_5v5));
+}
+
+/// Test 15: Brackets of one player are kept, removed and counted independently
+TEST_F(ArenaRatingStorageTest, PerPlayerBracketRecord)
+{
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2, ArenaRatingData(1600.0f, 90.0f, 0.06f, 10, 6, 4, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_5v5, ArenaRatingData(1400.0f, 120.0f, 0.06f, 4, 1, 3, ArenaBracket::SLOT_5v5));
+    EXPECT_EQ(sArenaRatingStorage->GetCacheSize(), 2u);
+
+    EXPECT_TRUE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_2v2));
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_3v3));
+    EXPECT_TRUE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_5v5));
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_5v5).bracket, ArenaBracket::SLOT_5v5);
+
+    // Removing one bracket leaves the others
+    sArenaRatingStorage->RemoveRating(player1Guid, ArenaBracket::SLOT_2v2);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_2v2));
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_5v5).rating, 1400.0f);
+    EXPECT_EQ(sArenaRatingStorage->GetCacheSize(), 1u);
+
+    // A removed bracket is no longer part of the matchmaking read
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetMatchmakingRating(player1Guid, ArenaBracket::SLOT_2v2).rating,
+        sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).rating);
+
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_3v3, ArenaRatingData(1700.0f, 70.0f, 0.06f, 20, 12, 8, ArenaBracket::SLOT_3v3));
+    sArenaRatingStorage->RemoveAllRatings(player1Guid);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_5v5));
+    EXPECT_TRUE(sArenaRatingStorage->HasRating(player2Guid, ArenaBracket::SLOT_3v3));
+    EXPECT_EQ(sArenaRatingStorage->GetCacheSize(), 1u);
+}
+
+/// Test 16: A new default rating reaches every missing bracket with its own bracket set
+TEST_F(ArenaRatingStorageTest, DefaultRatingRepublished)
+{
+    ArenaRatingData original = sArenaRatingStorage->GetRating(player3Guid, ArenaBracket::SLOT_2v2);
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2, ArenaRatingData(1600.0f, 90.0f, 0.06f, 10, 6, 4, ArenaBracket::SLOT_2v2));
+
+    sArenaRatingStorage->SetDefaultRating(1250.0f, 320.0f, 0.08f);
+    ArenaRatingData missing = sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3);
+    EXPECT_FLOAT_EQ(missing.rating, 1250.0f);
+    EXPECT_FLOAT_EQ(missing.ratingDeviation, 320.0f);
+    EXPECT_FLOAT_EQ(missing.volatility, 0.08f);
+    EXPECT_EQ(missing.bracket, ArenaBracket::SLOT_3v3);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetMatchmakingRating(player2Guid, ArenaBracket::SLOT_5v5).rating, 1250.0f);
+
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).rating, 1600.0f);
+
+    sArenaRatingStorage->SetDefaultRating(original.rating, original.ratingDeviation, original.volatility);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_2v2).rating, original.rating);
+}
+
+/// Test 17: A full cache evicts whole clean offline players; a login reloads only evicted ones
+TEST_F(ArenaRatingStorageTest, BoundedCacheEviction)
+{
+    constexpr uint32 FILLER_FIRST = 100100;
+    constexpr uint32 FILLER_COUNT = 200;
+
+    sArenaRatingStorage->SetMemoryBudget(1);
+    EXPECT_EQ(sArenaRatingStorage->GetCacheStats().capacity, sArenaRatingStorage->GetShardCount());
+
+    // Logged in, loaded clean: pinned
+    EXPECT_TRUE(sArenaRatingStorage->BeginLoad(player1Guid));
+    sArenaRatingStorage->CompleteLoad(player1Guid, ArenaBracket::SLOT_2v2, ArenaRatingData(1600.0f, 90.0f, 0.06f, 10, 6, 4, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->CompleteLoad(player1Guid);
+    sArenaRatingStorage->SetOnline(player1Guid, true);
+    EXPECT_FALSE(sArenaRatingStorage->BeginLoad(player1Guid));
+
+    // Offline with an unsaved bracket: pinned until saved
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_3v3, ArenaRatingData(1700.0f, 70.0f, 0.06f, 20, 12, 8, ArenaBracket::SLOT_3v3));
+
+    for (uint32 counter = FILLER_FIRST; counter < FILLER_FIRST + FILLER_COUNT; ++counter)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+        ASSERT_TRUE(sArenaRatingStorage->BeginLoad(guid));
+        sArenaRatingStorage->CompleteLoad(guid, ArenaBracket::SLOT_5v5, ArenaRatingData(1400.0f, 120.0f, 0.06f, 4, 1, 3, ArenaBracket::SLOT_5v5));
+        sArenaRatingStorage->CompleteLoad(guid);
+    }
+
+    EXPECT_TRUE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_2v2));
+    EXPECT_TRUE(sArenaRatingStorage->HasRating(player2Guid, ArenaBracket::SLOT_3v3));
+    EXPECT_LT(sArenaRatingStorage->GetCacheSize(), FILLER_COUNT / 4);
+    EXPECT_GT(sArenaRatingStorage->GetCacheStats().evictions, 0u);
+
+    for (uint32 counter = FILLER_FIRST; counter < FILLER_FIRST + FILLER_COUNT; ++counter)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+        bool cached = sArenaRatingStorage->HasRating(guid, ArenaBracket::SLOT_5v5);
+        EXPECT_EQ(sArenaRatingStorage->BeginLoad(guid), !cached);
+        if (!cached)
+            EXPECT_FLOAT_EQ(sArenaRatingStorage->GetMatchmakingRating(guid, ArenaBracket::SLOT_5v5).rating,
+                sArenaRatingStorage->GetRating(guid, ArenaBracket::SLOT_5v5).rating);
+    }
+
+    sArenaRatingStorage->SetOnline(player1Guid, false);
+    sArenaRatingStorage->SetMemoryBudget(0);
+}
+
+/// Test 18: Preloaded brackets of a player are cached together and never replace a cached record
+TEST_F(ArenaRatingStorageTest, PreloadCachesWholePlayer)
+{
+    std::vector<ArenaRatingData> brackets =
+    {
+        ArenaRatingData(1600.0f, 90.0f, 0.06f, 10, 6, 4, ArenaBracket::SLOT_2v2),
+        ArenaRatingData(1450.0f, 150.0f, 0.06f, 3, 1, 2, ArenaBracket::SLOT_5v5),
+    };
+
+    EXPECT_TRUE(sArenaRatingStorage->PreloadRatings(player1Guid, brackets));
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).rating, 1600.0f);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_5v5).bracket, ArenaBracket::SLOT_5v5);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetMatchmakingRating(player1Guid, ArenaBracket::SLOT_5v5).rating, 1450.0f);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player1Guid, ArenaBracket::SLOT_3v3));
+    EXPECT_FALSE(sArenaRatingStorage->BeginLoad(player1Guid));
+
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_2v2, ArenaRatingData(1800.0f, 60.0f, 0.06f, 40, 30, 10, ArenaBracket::SLOT_2v2));
+    EXPECT_TRUE(sArenaRatingStorage->PreloadRatings(player2Guid, brackets));
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_2v2).rating, 1800.0f);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player2Guid, ArenaBracket::SLOT_5v5));
+}
+
+/// Test 19: Update() changes one bracket in place, batches cover a whole match, no-op updates write nothing
+TEST_F(ArenaRatingStorageTest, AtomicUpdate)
+{
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(1600.0f, 100.0f, 0.06f, 10, 5, 5, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3,
+        ArenaRatingData(1700.0f, 100.0f, 0.06f, 10, 5, 5, ArenaBracket::SLOT_3v3));
+
+    sArenaRatingStorage->Update(player1Guid, ArenaBracket::SLOT_3v3, [](ArenaRatingData& data)
+    {
+        data.rating += 25.0f;
+        data.wins++;
+    });
+
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3).rating, 1725.0f);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3).wins, 6u);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).rating, 1600.0f);
+    EXPECT_FLOAT_EQ(sArenaRatingStorage->GetMatchmakingRating(player1Guid, ArenaBracket::SLOT_3v3).rating, 1725.0f);
+
+    constexpr uint32 THREADS = 4;
+    constexpr uint32 ROUNDS = 500;
+    std::vector<ObjectGuid> match = { player1Guid, player2Guid };
+
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&match]
+        {
+            for (uint32 i = 0; i < ROUNDS; ++i)
+            {
+                sArenaRatingStorage->Update(match, ArenaBracket::SLOT_2v2, [](std::span<ArenaRatingData> data)
+                {
+                    for (ArenaRatingData& player : data)
+                    {
+                        player.matchesPlayed++;
+                        player.loaded = true;
+                    }
+                });
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2).matchesPlayed, 10 + THREADS * ROUNDS);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_2v2).matchesPlayed, THREADS * ROUNDS);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_2v2).bracket, ArenaBracket::SLOT_2v2);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player2Guid, ArenaBracket::SLOT_3v3));
+
+    sArenaRatingStorage->Update(player3Guid, ArenaBracket::SLOT_5v5, [](ArenaRatingData&) { });
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player3Guid, ArenaBracket::SLOT_5v5));
+}
+
+/// Test 20: Batched matchmaking reads stay within the requested bracket
+TEST_F(ArenaRatingStorageTest, BatchedMatchmakingReads)
+{
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3,
+        ArenaRatingData(1800.0f, 60.0f, 0.06f, 10, 6, 4, ArenaBracket::SLOT_3v3));
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_3v3,
+        ArenaRatingData(1600.0f, 90.0f, 0.06f, 10, 4, 6, ArenaBracket::SLOT_3v3));
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(2200.0f, 40.0f, 0.06f, 10, 9, 1, ArenaBracket::SLOT_2v2));
+
+    std::vector<ObjectGuid> players = { player1Guid, player2Guid };
+    std::vector<Glicko2Rating> ratings(players.size());
+    sArenaRatingStorage->GetMatchmakingRatings(players, ArenaBracket::SLOT_3v3, ratings);
+
+    EXPECT_FLOAT_EQ(ratings[0].rating, 1800.0f);
+    EXPECT_FLOAT_EQ(ratings[1].rating, 1600.0f);
+    EXPECT_FLOAT_EQ(ratings[1].ratingDeviation, 90.0f);
+
+    Glicko2RatingSum sum = sArenaRatingStorage->SumMatchmakingRatings(players, ArenaBracket::SLOT_3v3);
+    EXPECT_EQ(sum.count, 2u);
+    EXPECT_FLOAT_EQ(sum.GetAverageRating(0.0f), 1700.0f);
+    EXPECT_FLOAT_EQ(sum.GetAverageRatingDeviation(0.0f), 75.0f);
+
+    sum = sArenaRatingStorage->SumMatchmakingRatings(std::vector<ObjectGuid>{ player3Guid }, ArenaBracket::SLOT_5v5);
+    EXPECT_FLOAT_EQ(sum.rating, sArenaRatingStorage->GetRating(player3Guid, ArenaBracket::SLOT_5v5).rating);
+}
+
+/// Test 21: Saves write only changed brackets and leave records changed meanwhile dirty
+TEST_F(ArenaRatingStorageTest, SavesOnlyChangedBrackets)
+{
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(1600.0f, 100.0f, 0.06f, 10, 5, 5, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->SetRating(player2Guid, ArenaBracket::SLOT_3v3, ArenaRatingData());
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 1u) << "Defaults are never written";
+
+    sArenaRatingStorage->SaveAllRatings(player1Guid);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    // Removing the only changed bracket leaves nothing to write
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_5v5,
+        ArenaRatingData(1500.0f, 300.0f, 0.06f, 1, 1, 0, ArenaBracket::SLOT_5v5));
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 1u);
+    sArenaRatingStorage->RemoveRating(player1Guid, ArenaBracket::SLOT_5v5);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    // Each changed bracket of a player counts once
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(1610.0f, 100.0f, 0.06f, 11, 6, 5, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3,
+        ArenaRatingData(1550.0f, 150.0f, 0.06f, 3, 2, 1, ArenaBracket::SLOT_3v3));
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 2u);
+    sArenaRatingStorage->SaveAllRatings(player1Guid);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    // Snapshots taken while matches commit never deadlock with them
+    std::vector<ObjectGuid> match = { player1Guid, player2Guid, player3Guid };
+    for (ObjectGuid guid : match)
+    {
+        sArenaRatingStorage->BeginLoad(guid);
+        sArenaRatingStorage->CompleteLoad(guid);
+    }
+
+    std::thread writer([&match]
+    {
+        for (uint32 i = 0; i < 500; ++i)
+        {
+            sArenaRatingStorage->Update(match, ArenaBracket::SLOT_2v2, [](std::span<ArenaRatingData> data)
+            {
+                for (ArenaRatingData& player : data)
+                    player.matchesPlayed++;
+            });
+        }
+    });
+
+    for (uint32 i = 0; i < 50; ++i)
+        sArenaRatingStorage->SaveAll();
+
+    writer.join();
+    EXPECT_GT(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    sArenaRatingStorage->SaveAll();
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+    EXPECT_EQ(sArenaRatingStorage->GetRating(player3Guid, ArenaBracket::SLOT_2v2).matchesPlayed, 500u);
+}
+
+/// Test 22: Matches rated on the defaults while a login load is in flight are merged into the row
+TEST_F(ArenaRatingStorageTest, MatchDuringLoginLoad)
+{
+    auto playMatch = [](ArenaRatingData& data)
+    {
+        data.rating += 120.0f;
+        data.matchesPlayed++;
+        data.wins++;
+        data.lastMatchTime = 1760000000;
+    };
+
+    // Earlier matches in the row: it wins, only the counts carry over
+    ASSERT_TRUE(sArenaRatingStorage->BeginLoad(player1Guid));
+    sArenaRatingStorage->Update(player1Guid, ArenaBracket::SLOT_2v2, playMatch);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 0u);
+
+    sArenaRatingStorage->CompleteLoad(player1Guid, ArenaBracket::SLOT_2v2,
+        ArenaRatingData(1800.0f, 60.0f, 0.05f, 40, 25, 15, ArenaBracket::SLOT_2v2));
+    sArenaRatingStorage->CompleteLoad(player1Guid);
+
+    ArenaRatingData merged = sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_2v2);
+    EXPECT_TRUE(merged.loaded);
+    EXPECT_FLOAT_EQ(merged.rating, 1800.0f);
+    EXPECT_EQ(merged.matchesPlayed, 41u);
+    EXPECT_EQ(merged.wins, 26u);
+    EXPECT_EQ(merged.lastMatchTime, 1760000000u);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 1u);
+    EXPECT_FALSE(sArenaRatingStorage->BeginLoad(player1Guid));
+
+    // No row: the defaults were the player's rating, so the result is kept and saved
+    float startingRating = sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_3v3).rating;
+    ASSERT_TRUE(sArenaRatingStorage->BeginLoad(player2Guid));
+    sArenaRatingStorage->Update(player2Guid, ArenaBracket::SLOT_3v3, playMatch);
+    sArenaRatingStorage->CompleteLoad(player2Guid);
+
+    ArenaRatingData kept = sArenaRatingStorage->GetRating(player2Guid, ArenaBracket::SLOT_3v3);
+    EXPECT_TRUE(kept.loaded);
+    EXPECT_FLOAT_EQ(kept.rating, startingRating + 120.0f);
+    EXPECT_EQ(sArenaRatingStorage->GetDirtyCount(), 2u);
+
+    // A record rated on the defaults without a load still fetches its rows at the next login
+    sArenaRatingStorage->Update(player3Guid, ArenaBracket::SLOT_5v5, playMatch);
+    EXPECT_TRUE(sArenaRatingStorage->BeginLoad(player3Guid));
+
+    // Deleted while the query was in flight: the rows do not bring the record back
+    sArenaRatingStorage->RemoveAllRatings(player3Guid);
+    EXPECT_FALSE(sArenaRatingStorage->IsPending(player3Guid));
+    sArenaRatingStorage->CompleteLoad(player3Guid, ArenaBracket::SLOT_5v5,
+        ArenaRatingData(1500.0f, 100.0f, 0.06f, 10, 5, 5, ArenaBracket::SLOT_5v5));
+    sArenaRatingStorage->CompleteLoad(player3Guid);
+    EXPECT_FALSE(sArenaRatingStorage->HasRating(player3Guid, ArenaBracket::SLOT_5v5));
+
+    sArenaRatingStorage->SaveAll();
+}
@@ -18,6 +18,9 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "Glicko2PlayerStorage.h"
+#include <cmath>
+#include <thread>
+#include <vector>
 
 /// Test fixture for Glicko2 Player Storage tests (Battleground MMR)
 /// Tests focus on cache operations and data consistency
@@ -270,3 +273,366 @@ TEST_F(Glicko2PlayerStorageTest, RatingValuesReasonableBounds)
     EXPECT_FLOAT_EQ(retrieved.volatility, 0.1f);
     EXPECT_EQ(retrieved.matchesPlayed, 1000);
 }
+
+/// Test 13: Inactivity decay is applied on read from last_match_time
+TEST_F(Glicko2PlayerStorageTest, InactivityDecayAppliedOnRead)
+{
+    constexpr uint32 period = 7 * 24 * 3600;
+    sGlicko2Storage->SetInactivityDecay(period, 350.0f);
+
+    // Last match three and a half periods ago: three whole periods of decay
+    BattlegroundRatingData idle(1800.0f, 60.0f, 0.06f, 50, 30, 20);
+    idle.lastMatchTime = static_cast<uint32>(time(nullptr)) - period * 7 / 2;
+    sGlicko2Storage->SetRating(player1Guid, idle);
+
+    // Never played: no anchor, no decay
+    BattlegroundRatingData fresh(1500.0f, 200.0f, 0.06f, 0, 0, 0);
+    sGlicko2Storage->SetRating(player2Guid, fresh);
+
+    float sigmaScaled = 0.06f * 173.7178f;
+    float expectedRD = std::sqrt(60.0f * 60.0f + 3.0f * sigmaScaled * sigmaScaled);
+
+    BattlegroundRatingData retrieved = sGlicko2Storage->GetRating(player1Guid);
+    EXPECT_NEAR(retrieved.ratingDeviation, expectedRD, 0.01f);
+    EXPECT_FLOAT_EQ(retrieved.rating, 1800.0f);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player2Guid).ratingDeviation, 200.0f);
+
+    // Years away: capped at the configured maximum
+    idle.lastMatchTime = 1;
+    sGlicko2Storage->SetRating(player1Guid, idle);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).ratingDeviation, 350.0f);
+
+    sGlicko2Storage->SetInactivityDecay(0, 350.0f);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).ratingDeviation, 60.0f);
+}
+
+/// Test 14: Only changed entries are dirty and saving cleans them
+TEST_F(Glicko2PlayerStorageTest, DirtyTrackingWriteBehind)
+{
+    sGlicko2Storage->ClearCache();
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 0u);
+
+    BattlegroundRatingData data(1600.0f, 150.0f, 0.06f, 5, 3, 2);
+    sGlicko2Storage->SetRating(player1Guid, data);
+    sGlicko2Storage->SetRating(player2Guid, data);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 2u);
+
+    sGlicko2Storage->SaveRating(player1Guid);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+
+    sGlicko2Storage->SaveAll();
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 0u);
+
+    // Writing back identical data does not schedule a save
+    sGlicko2Storage->SetRating(player1Guid, data);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 0u);
+
+    data.rating = 1625.0f;
+    sGlicko2Storage->SetRating(player1Guid, data);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+
+    // Unloaded entries are never written
+    sGlicko2Storage->SetRating(player3Guid, BattlegroundRatingData());
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+}
+
+/// Test 15: Async login loads leave the player pending on defaults until they land
+TEST_F(Glicko2PlayerStorageTest, AsyncLoadPendingState)
+{
+    sGlicko2Storage->ClearCache();
+
+    EXPECT_TRUE(sGlicko2Storage->BeginLoad(player1Guid));
+    EXPECT_TRUE(sGlicko2Storage->IsPending(player1Guid));
+    EXPECT_FALSE(sGlicko2Storage->HasRating(player1Guid));
+    EXPECT_FALSE(sGlicko2Storage->GetRating(player1Guid).loaded);
+    EXPECT_EQ(sGlicko2Storage->GetRating(player1Guid).matchesPlayed, 0u);
+
+    // A second login while the first load is in flight does not queue another
+    EXPECT_FALSE(sGlicko2Storage->BeginLoad(player1Guid));
+    EXPECT_EQ(sGlicko2Storage->GetPendingCount(), 1u);
+
+    // Entries kept from an earlier session are current and skip the query
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1700.0f, 80.0f, 0.06f, 10, 6, 4));
+    EXPECT_FALSE(sGlicko2Storage->BeginLoad(player2Guid));
+    EXPECT_FALSE(sGlicko2Storage->IsPending(player2Guid));
+
+    // The loaded row lands clean
+    sGlicko2Storage->CompleteLoad(player1Guid, BattlegroundRatingData(1650.0f, 90.0f, 0.06f, 20, 11, 9));
+    EXPECT_FALSE(sGlicko2Storage->IsPending(player1Guid));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1650.0f);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+
+    // A rating set while loading is newer than the row and is kept
+    EXPECT_TRUE(sGlicko2Storage->BeginLoad(player3Guid));
+    sGlicko2Storage->SetRating(player3Guid, BattlegroundRatingData(1550.0f, 300.0f, 0.06f, 1, 1, 0));
+    sGlicko2Storage->CompleteLoad(player3Guid, BattlegroundRatingData(1400.0f, 100.0f, 0.06f, 50, 20, 30));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player3Guid).rating, 1550.0f);
+
+    // Deleting the character drops the pending load
+    EXPECT_TRUE(sGlicko2Storage->BeginLoad(ObjectGuid::Create<HighGuid::Player>(200004)));
+    sGlicko2Storage->RemoveRating(ObjectGuid::Create<HighGuid::Player>(200004));
+    EXPECT_EQ(sGlicko2Storage->GetPendingCount(), 0u);
+    sGlicko2Storage->CompleteLoad(ObjectGuid::Create<HighGuid::Player>(200004), BattlegroundRatingData());
+    EXPECT_FALSE(sGlicko2Storage->HasRating(ObjectGuid::Create<HighGuid::Player>(200004)));
+}
+
+/// Test 16: The lock-free matchmaking read follows every cache write
+TEST_F(Glicko2PlayerStorageTest, MatchmakingRatingTracksCache)
+{
+    sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1720.0f, 85.0f, 0.05f, 12, 8, 4));
+    Glicko2Rating rating = sGlicko2Storage->GetMatchmakingRating(player1Guid);
+    EXPECT_FLOAT_EQ(rating.rating, 1720.0f);
+    EXPECT_FLOAT_EQ(rating.ratingDeviation, 85.0f);
+    EXPECT_FLOAT_EQ(rating.volatility, 0.05f);
+
+    sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1705.0f, 84.0f, 0.05f, 13, 8, 5));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player1Guid).rating, 1705.0f);
+
+    // Matches GetRating() for cached players, falls back to defaults once removed
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player1Guid).ratingDeviation,
+        sGlicko2Storage->GetRating(player1Guid).ratingDeviation);
+
+    sGlicko2Storage->RemoveRating(player1Guid);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player1Guid).rating,
+        sGlicko2Storage->GetRating(player1Guid).rating);
+
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1900.0f, 60.0f, 0.06f, 30, 20, 10));
+    sGlicko2Storage->ClearCache();
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player2Guid).rating,
+        sGlicko2Storage->GetRating(player2Guid).rating);
+}
+
+/// Test 17: A new default rating reaches cache misses without touching cached players
+TEST_F(Glicko2PlayerStorageTest, DefaultRatingRepublished)
+{
+    BattlegroundRatingData original = sGlicko2Storage->GetDefaultRating();
+    sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1720.0f, 85.0f, 0.05f, 12, 8, 4));
+
+    sGlicko2Storage->SetDefaultRating(1200.0f, 300.0f, 0.07f);
+    BattlegroundRatingData missing = sGlicko2Storage->GetRating(player2Guid);
+    EXPECT_FLOAT_EQ(missing.rating, 1200.0f);
+    EXPECT_FLOAT_EQ(missing.ratingDeviation, 300.0f);
+    EXPECT_FLOAT_EQ(missing.volatility, 0.07f);
+    EXPECT_FALSE(missing.loaded);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player2Guid).rating, 1200.0f);
+    EXPECT_TRUE(sGlicko2Storage->GetDefaultRating().loaded);
+
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1720.0f);
+
+    sGlicko2Storage->SetDefaultRating(original.rating, original.ratingDeviation, original.volatility);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player2Guid).rating, original.rating);
+}
+
+/// Test 18: A full cache evicts clean offline players and keeps online and unsaved ones
+TEST_F(Glicko2PlayerStorageTest, BoundedCacheEviction)
+{
+    constexpr uint32 FILLER_FIRST = 200100;
+    constexpr uint32 FILLER_COUNT = 200;
+
+    // The smallest budget leaves one entry per shard
+    sGlicko2Storage->SetMemoryBudget(1);
+    Glicko2CacheStats before = sGlicko2Storage->GetCacheStats();
+    EXPECT_EQ(before.capacity, sGlicko2Storage->GetShardCount());
+
+    ASSERT_TRUE(sGlicko2Storage->BeginLoad(player1Guid));
+    sGlicko2Storage->CompleteLoad(player1Guid, BattlegroundRatingData(1800.0f, 70.0f, 0.06f, 40, 25, 15));
+    sGlicko2Storage->SetOnline(player1Guid, true);
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1650.0f, 90.0f, 0.06f, 10, 6, 4));
+
+    for (uint32 counter = FILLER_FIRST; counter < FILLER_FIRST + FILLER_COUNT; ++counter)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+        ASSERT_TRUE(sGlicko2Storage->BeginLoad(guid));
+        sGlicko2Storage->CompleteLoad(guid, BattlegroundRatingData(1500.0f + counter % 100, 200.0f, 0.06f, 1, 1, 0));
+    }
+
+    EXPECT_TRUE(sGlicko2Storage->HasRating(player1Guid));
+    EXPECT_TRUE(sGlicko2Storage->HasRating(player2Guid));
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+    EXPECT_LT(sGlicko2Storage->GetCacheSize(), FILLER_COUNT / 4);
+
+    // Evicted players read as defaults through both paths until their next login
+    size_t evicted = 0;
+    for (uint32 counter = FILLER_FIRST; counter < FILLER_FIRST + FILLER_COUNT; ++counter)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+        if (sGlicko2Storage->HasRating(guid))
+            continue;
+
+        ++evicted;
+        EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(guid).rating, sGlicko2Storage->GetDefaultRating().rating);
+        EXPECT_TRUE(sGlicko2Storage->BeginLoad(guid));
+    }
+
+    Glicko2CacheStats after = sGlicko2Storage->GetCacheStats();
+    EXPECT_EQ(after.evictions - before.evictions, evicted);
+
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1800.0f);
+    sGlicko2Storage->GetRating(ObjectGuid::Create<HighGuid::Player>(FILLER_FIRST + FILLER_COUNT));
+    EXPECT_EQ(sGlicko2Storage->GetCacheStats().hits, after.hits + 1);
+    EXPECT_EQ(sGlicko2Storage->GetCacheStats().misses, after.misses + 1);
+
+    sGlicko2Storage->SetOnline(player1Guid, false);
+    sGlicko2Storage->SetMemoryBudget(0);
+}
+
+/// Test 19: Preloaded rows are cached clean, never replace cached entries and never evict
+TEST_F(Glicko2PlayerStorageTest, PreloadRespectsCacheAndBudget)
+{
+    EXPECT_TRUE(sGlicko2Storage->PreloadRating(player1Guid, BattlegroundRatingData(1750.0f, 80.0f, 0.06f, 30, 18, 12)));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1750.0f);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player1Guid).rating, 1750.0f);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 0u);
+    EXPECT_FALSE(sGlicko2Storage->BeginLoad(player1Guid));
+
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1600.0f, 90.0f, 0.06f, 5, 3, 2));
+    EXPECT_TRUE(sGlicko2Storage->PreloadRating(player2Guid, BattlegroundRatingData(1400.0f, 90.0f, 0.06f, 4, 2, 2)));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player2Guid).rating, 1600.0f);
+
+    // One entry per shard: shards already holding one refuse further rows
+    sGlicko2Storage->SetMemoryBudget(1);
+    uint64 evictions = sGlicko2Storage->GetCacheStats().evictions;
+    size_t refused = 0;
+    for (uint32 counter = 200400; counter < 200500; ++counter)
+        if (!sGlicko2Storage->PreloadRating(ObjectGuid::Create<HighGuid::Player>(counter), BattlegroundRatingData(1500.0f, 200.0f, 0.06f, 1, 1, 0)))
+            ++refused;
+
+    EXPECT_GT(refused, 0u);
+    EXPECT_TRUE(sGlicko2Storage->HasRating(player1Guid));
+    EXPECT_EQ(sGlicko2Storage->GetCacheStats().evictions, evictions);
+    sGlicko2Storage->SetMemoryBudget(0);
+}
+
+/// Test 20: Concurrent Update() calls and match batches lose no changes; no-op updates write nothing
+TEST_F(Glicko2PlayerStorageTest, AtomicUpdate)
+{
+    sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1500.0f, 200.0f, 0.06f, 0, 0, 0));
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1500.0f, 200.0f, 0.06f, 0, 0, 0));
+
+    constexpr uint32 THREADS = 4;
+    constexpr uint32 ROUNDS = 1000;
+    std::vector<ObjectGuid> match = { player1Guid, player2Guid };
+
+    // Even threads update player 1 alone, odd ones move a point from player 1 to player 2 as a match
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([this, &match, t]
+        {
+            for (uint32 i = 0; i < ROUNDS; ++i)
+            {
+                if (t % 2 == 0)
+                {
+                    sGlicko2Storage->Update(player1Guid, [](BattlegroundRatingData& data)
+                    {
+                        data.matchesPlayed++;
+                        data.wins++;
+                    });
+
+                    continue;
+                }
+
+                sGlicko2Storage->Update(match, [](std::span<BattlegroundRatingData> data)
+                {
+                    data[0].rating -= 1.0f;
+                    data[0].matchesPlayed++;
+                    data[0].losses++;
+                    data[1].rating += 1.0f;
+                    data[1].matchesPlayed++;
+                    data[1].wins++;
+                });
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    BattlegroundRatingData player1 = sGlicko2Storage->GetRating(player1Guid);
+    BattlegroundRatingData player2 = sGlicko2Storage->GetRating(player2Guid);
+    EXPECT_EQ(player1.matchesPlayed, THREADS * ROUNDS);
+    EXPECT_EQ(player1.wins, THREADS / 2 * ROUNDS);
+    EXPECT_EQ(player1.losses, THREADS / 2 * ROUNDS);
+    EXPECT_EQ(player2.matchesPlayed, THREADS / 2 * ROUNDS);
+    EXPECT_FLOAT_EQ(player1.rating + player2.rating, 3000.0f);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetMatchmakingRating(player2Guid).rating, player2.rating);
+
+    sGlicko2Storage->Update(player3Guid, [](BattlegroundRatingData&) { });
+    EXPECT_FALSE(sGlicko2Storage->HasRating(player3Guid));
+}
+
+/// Test 21: Batched matchmaking reads match single reads for cached and uncached players
+TEST_F(Glicko2PlayerStorageTest, BatchedMatchmakingReads)
+{
+    sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1700.0f, 80.0f, 0.06f, 10, 6, 4));
+    sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1300.0f, 120.0f, 0.06f, 10, 4, 6));
+
+    std::vector<ObjectGuid> players = { player1Guid, player2Guid, player3Guid };
+    std::vector<Glicko2Rating> ratings(players.size());
+    sGlicko2Storage->GetMatchmakingRatings(players, ratings);
+
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        Glicko2Rating single = sGlicko2Storage->GetMatchmakingRating(players[i]);
+        EXPECT_FLOAT_EQ(ratings[i].rating, single.rating);
+        EXPECT_FLOAT_EQ(ratings[i].ratingDeviation, single.ratingDeviation);
+    }
+
+    EXPECT_FLOAT_EQ(ratings[2].rating, sGlicko2Storage->GetDefaultRating().rating);
+
+    Glicko2RatingSum sum = sGlicko2Storage->SumMatchmakingRatings(players);
+    EXPECT_EQ(sum.count, 3u);
+    EXPECT_FLOAT_EQ(sum.rating, 3000.0f + ratings[2].rating);
+    EXPECT_FLOAT_EQ(sum.ratingDeviation, 200.0f + ratings[2].ratingDeviation);
+
+    EXPECT_EQ(sGlicko2Storage->SumMatchmakingRatings(std::vector<ObjectGuid>()).count, 0u);
+}
+
+/// Test 22: Matches rated on the defaults while a login load is in flight are merged into the row
+TEST_F(Glicko2PlayerStorageTest, MatchDuringLoginLoad)
+{
+    sGlicko2Storage->ClearCache();
+
+    auto playMatch = [](BattlegroundRatingData& data)
+    {
+        data.rating += 120.0f;
+        data.matchesPlayed++;
+        data.losses++;
+        data.lastMatchTime = 1760000000;
+    };
+
+    // Earlier matches in the row: it wins, only the counts carry over
+    ASSERT_TRUE(sGlicko2Storage->BeginLoad(player1Guid));
+    sGlicko2Storage->Update(player1Guid, playMatch);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 0u);
+
+    sGlicko2Storage->CompleteLoad(player1Guid, BattlegroundRatingData(1400.0f, 100.0f, 0.06f, 50, 20, 30));
+
+    BattlegroundRatingData merged = sGlicko2Storage->GetRating(player1Guid);
+    EXPECT_TRUE(merged.loaded);
+    EXPECT_FLOAT_EQ(merged.rating, 1400.0f);
+    EXPECT_EQ(merged.matchesPlayed, 51u);
+    EXPECT_EQ(merged.losses, 31u);
+    EXPECT_EQ(merged.lastMatchTime, 1760000000u);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 1u);
+    EXPECT_FALSE(sGlicko2Storage->BeginLoad(player1Guid));
+
+    // No row: the defaults were the player's rating, so the result is kept and saved
+    ASSERT_TRUE(sGlicko2Storage->BeginLoad(player2Guid));
+    sGlicko2Storage->Update(player2Guid, playMatch);
+    sGlicko2Storage->CompleteLoad(player2Guid, sGlicko2Storage->GetDefaultRating());
+
+    BattlegroundRatingData kept = sGlicko2Storage->GetRating(player2Guid);
+    EXPECT_TRUE(kept.loaded);
+    EXPECT_FLOAT_EQ(kept.rating, sGlicko2Storage->GetDefaultRating().rating + 120.0f);
+    EXPECT_EQ(sGlicko2Storage->GetDirtyCount(), 2u);
+
+    // An entry rated on the defaults without a load still fetches its row at the next login
+    sGlicko2Storage->Update(player3Guid, playMatch);
+    EXPECT_TRUE(sGlicko2Storage->BeginLoad(player3Guid));
+    sGlicko2Storage->CompleteLoad(player3Guid, BattlegroundRatingData(1600.0f, 80.0f, 0.06f, 10, 6, 4));
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player3Guid).rating, 1600.0f);
+    EXPECT_EQ(sGlicko2Storage->GetRating(player3Guid).matchesPlayed, 11u);
+
+    sGlicko2Storage->SaveAll();
+}
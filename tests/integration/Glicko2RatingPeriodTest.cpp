@@ -0,0 +1,117 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2RatingPeriod.h"
+#include "Glicko2PlayerStorage.h"
+#include "ArenaRatingStorage.h"
+
+/// Test fixture for rating period accumulation and commit
+/// Results are added and committed directly; the config switch only routes match ends here
+class Glicko2RatingPeriodTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        sGlicko2RatingPeriodMgr->CommitPeriod();
+
+        player1Guid = ObjectGuid::Create<HighGuid::Player>(400001);
+        player2Guid = ObjectGuid::Create<HighGuid::Player>(400002);
+
+        sGlicko2Storage->SetRating(player1Guid, BattlegroundRatingData(1500.0f, 200.0f, 0.06f, 0, 0, 0));
+        sGlicko2Storage->SetRating(player2Guid, BattlegroundRatingData(1700.0f, 80.0f, 0.05f, 0, 0, 0));
+    }
+
+    void TearDown() override
+    {
+        sGlicko2RatingPeriodMgr->CommitPeriod();
+        sGlicko2Storage->RemoveRating(player1Guid);
+        sGlicko2Storage->RemoveRating(player2Guid);
+        sArenaRatingStorage->RemoveRating(player1Guid, ArenaBracket::SLOT_3v3);
+    }
+
+    ObjectGuid player1Guid;
+    ObjectGuid player2Guid;
+};
+
+/// Test 1: Results wait in the buffer until the period is committed
+TEST_F(Glicko2RatingPeriodTest, ResultsAreDeferredUntilCommit)
+{
+    sGlicko2RatingPeriodMgr->AddResult(player1Guid, Glicko2RatingPool::BATTLEGROUND, Glicko2Opponent(1400.0f, 30.0f, 1.0f));
+    sGlicko2RatingPeriodMgr->AddResult(player1Guid, Glicko2RatingPool::BATTLEGROUND, Glicko2Opponent(1550.0f, 100.0f, 0.0f));
+
+    EXPECT_EQ(sGlicko2RatingPeriodMgr->GetPendingCount(), 1u);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1500.0f);
+
+    sGlicko2RatingPeriodMgr->CommitPeriod();
+
+    EXPECT_EQ(sGlicko2RatingPeriodMgr->GetPendingCount(), 0u);
+    EXPECT_NE(sGlicko2Storage->GetRating(player1Guid).rating, 1500.0f);
+}
+
+/// Test 2: A committed period equals one multi-opponent Glicko-2 update (Glickman's example)
+TEST_F(Glicko2RatingPeriodTest, CommitMatchesSingleRatingPeriodUpdate)
+{
+    std::vector<Glicko2Opponent> opponents = {
+        Glicko2Opponent(1400.0f, 30.0f, 1.0f),
+        Glicko2Opponent(1550.0f, 100.0f, 0.0f),
+        Glicko2Opponent(1700.0f, 300.0f, 0.0f)
+    };
+
+    for (Glicko2Opponent const& opponent : opponents)
+        sGlicko2RatingPeriodMgr->AddResult(player1Guid, Glicko2RatingPool::BATTLEGROUND, opponent);
+
+    sGlicko2RatingPeriodMgr->CommitPeriod();
+
+    Glicko2Rating expected = Glicko2System(0.5f).UpdateRating(Glicko2Rating(1500.0f, 200.0f, 0.06f), opponents);
+    BattlegroundRatingData committed = sGlicko2Storage->GetRating(player1Guid);
+
+    EXPECT_NEAR(committed.rating, expected.rating, 0.01f);
+    EXPECT_NEAR(committed.ratingDeviation, expected.ratingDeviation, 0.01f);
+    EXPECT_NEAR(committed.volatility, expected.volatility, 0.00001f);
+}
+
+/// Test 3: Committing one player (logout) leaves everyone else pending
+TEST_F(Glicko2RatingPeriodTest, CommitPlayerOnlyFlushesThatPlayer)
+{
+    sGlicko2RatingPeriodMgr->AddResult(player1Guid, Glicko2RatingPool::BATTLEGROUND, Glicko2Opponent(1400.0f, 30.0f, 1.0f));
+    sGlicko2RatingPeriodMgr->AddResult(player2Guid, Glicko2RatingPool::BATTLEGROUND, Glicko2Opponent(1400.0f, 30.0f, 1.0f));
+
+    sGlicko2RatingPeriodMgr->CommitPlayer(player1Guid);
+
+    EXPECT_EQ(sGlicko2RatingPeriodMgr->GetPendingCount(), 1u);
+    EXPECT_GT(sGlicko2Storage->GetRating(player1Guid).rating, 1500.0f);
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player2Guid).rating, 1700.0f);
+}
+
+/// Test 4: Arena results land in their own bracket and keep match counters
+TEST_F(Glicko2RatingPeriodTest, ArenaPoolCommitsToItsBracket)
+{
+    ArenaRatingData data(1500.0f, 200.0f, 0.06f, 4, 3, 1, ArenaBracket::SLOT_3v3);
+    sArenaRatingStorage->SetRating(player1Guid, ArenaBracket::SLOT_3v3, data);
+
+    sGlicko2RatingPeriodMgr->AddResult(player1Guid, GetArenaRatingPool(ArenaBracket::SLOT_3v3),
+        Glicko2Opponent(1600.0f, 80.0f, 1.0f));
+    sGlicko2RatingPeriodMgr->CommitPeriod();
+
+    ArenaRatingData committed = sArenaRatingStorage->GetRating(player1Guid, ArenaBracket::SLOT_3v3);
+    EXPECT_GT(committed.rating, 1500.0f);
+    EXPECT_EQ(committed.matchesPlayed, 4u);
+    EXPECT_EQ(committed.wins, 3u);
+
+    EXPECT_FLOAT_EQ(sGlicko2Storage->GetRating(player1Guid).rating, 1500.0f);
+}
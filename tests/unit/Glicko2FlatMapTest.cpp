@@ -0,0 +1,105 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2FlatMap.h"
+#include <random>
+#include <unordered_map>
+
+/// Test 1: Insert, overwrite, find and erase single keys
+TEST(Glicko2FlatMapTest, BasicOperations)
+{
+    Glicko2FlatMap<uint32_t, float> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(7), map.end());
+
+    auto [itr, inserted] = map.try_emplace(7, 1500.0f);
+    EXPECT_TRUE(inserted);
+    EXPECT_FLOAT_EQ(itr->second, 1500.0f);
+
+    // try_emplace keeps an existing value, operator[] overwrites it
+    EXPECT_FALSE(map.try_emplace(7, 1.0f).second);
+    EXPECT_FLOAT_EQ(map.find(7)->second, 1500.0f);
+    map[7] = 1620.0f;
+    EXPECT_FLOAT_EQ(map.find(7)->second, 1620.0f);
+
+    EXPECT_TRUE(map.contains(7));
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.erase(7), 1u);
+    EXPECT_EQ(map.erase(7), 0u);
+    EXPECT_FALSE(map.contains(7));
+    EXPECT_TRUE(map.empty());
+}
+
+/// Test 2: Random inserts and erases agree with std::unordered_map
+TEST(Glicko2FlatMapTest, MatchesUnorderedMap)
+{
+    Glicko2FlatMap<uint32_t, uint32_t> map;
+    std::unordered_map<uint32_t, uint32_t> reference;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> pick(1, 4000);
+
+    for (uint32_t step = 0; step < 50000; ++step)
+    {
+        uint32_t key = pick(rng);
+        if (step % 3 == 0)
+            EXPECT_EQ(map.erase(key), reference.erase(key));
+        else
+        {
+            map[key] = step;
+            reference[key] = step;
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (auto const& [key, value] : reference)
+    {
+        auto itr = map.find(key);
+        ASSERT_NE(itr, map.end()) << key;
+        EXPECT_EQ(itr->second, value);
+    }
+
+    // Iteration visits each live entry exactly once
+    size_t visited = 0;
+    for (auto const& [key, value] : map)
+    {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, reference.size());
+}
+
+/// Test 3: reserve() sizes the table once; the slot array is the whole footprint
+TEST(Glicko2FlatMapTest, ReserveAndMemory)
+{
+    Glicko2FlatMap<uint32_t, uint64_t> map;
+    map.reserve(1000);
+    size_t capacity = map.capacity();
+    EXPECT_GE(capacity * 7, 1000u * 8);
+
+    for (uint32_t key = 1; key <= 1000; ++key)
+        map.try_emplace(key, key);
+
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(map.GetMemoryUsage(), capacity * sizeof(std::pair<uint32_t, uint64_t>));
+
+    map.clear();
+    EXPECT_EQ(map.size(), 0u);
+    EXPECT_EQ(map.GetMemoryUsage(), 0u);
+}
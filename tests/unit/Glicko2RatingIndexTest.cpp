@@ -0,0 +1,143 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2RatingIndex.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    Glicko2RatingSnapshot MakeSnapshot(float rating)
+    {
+        Glicko2RatingSnapshot snapshot;
+        snapshot.rating = rating;
+        snapshot.ratingDeviation = rating / 10.0f;
+        snapshot.volatility = 0.06f;
+        snapshot.lastMatchTime = static_cast<uint32_t>(rating);
+        return snapshot;
+    }
+}
+
+/// Test 1: Published snapshots are found, overwritten in place and removed
+TEST(Glicko2RatingIndexTest, PublishFindRemove)
+{
+    Glicko2RatingIndex index(4);
+    Glicko2RatingSnapshot snapshot;
+
+    EXPECT_FALSE(index.Find(42, snapshot));
+
+    index.Publish(42, MakeSnapshot(1500.0f));
+    ASSERT_TRUE(index.Find(42, snapshot));
+    EXPECT_FLOAT_EQ(snapshot.rating, 1500.0f);
+    EXPECT_FLOAT_EQ(snapshot.ratingDeviation, 150.0f);
+    EXPECT_EQ(snapshot.lastMatchTime, 1500u);
+
+    index.Publish(42, MakeSnapshot(1620.0f));
+    ASSERT_TRUE(index.Find(42, snapshot));
+    EXPECT_FLOAT_EQ(snapshot.rating, 1620.0f);
+    EXPECT_EQ(index.Size(), 1u);
+
+    index.Remove(42);
+    EXPECT_FALSE(index.Find(42, snapshot));
+    EXPECT_EQ(index.Size(), 0u);
+}
+
+/// Test 2: Growth, tombstone reuse and Resize() keep every live key reachable
+TEST(Glicko2RatingIndexTest, GrowthAndChurn)
+{
+    Glicko2RatingIndex index(2);
+    for (uint64_t key = 1; key <= 5000; ++key)
+        index.Publish(key, MakeSnapshot(static_cast<float>(key)));
+
+    // Login/logout churn: drop half, add new keys over the tombstones
+    for (uint64_t key = 1; key <= 5000; key += 2)
+        index.Remove(key);
+    for (uint64_t key = 5001; key <= 7500; ++key)
+        index.Publish(key, MakeSnapshot(static_cast<float>(key)));
+
+    index.Resize(16);
+    EXPECT_EQ(index.GetStripeCount(), 16u);
+    EXPECT_EQ(index.Size(), 5000u);
+
+    Glicko2RatingSnapshot snapshot;
+    for (uint64_t key = 1; key <= 7500; ++key)
+    {
+        bool live = key > 5000 || key % 2 == 0;
+        ASSERT_EQ(index.Find(key, snapshot), live) << key;
+        if (live)
+            EXPECT_FLOAT_EQ(snapshot.rating, static_cast<float>(key));
+    }
+
+    index.Clear();
+    EXPECT_EQ(index.Size(), 0u);
+    EXPECT_FALSE(index.Find(2, snapshot));
+}
+
+/// Test 3: Readers racing a writer never see a torn snapshot
+TEST(Glicko2RatingIndexTest, ReadersSeeWholeSnapshots)
+{
+    Glicko2RatingIndex index(1);
+    for (uint64_t key = 1; key <= 64; ++key)
+        index.Publish(key, MakeSnapshot(1000.0f));
+
+    std::atomic<bool> stop = false;
+    std::atomic<uint32_t> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            Glicko2RatingSnapshot snapshot;
+            while (!stop.load(std::memory_order_relaxed))
+                for (uint64_t key = 1; key <= 64; ++key)
+                    if (index.Find(key, snapshot) && snapshot.ratingDeviation != snapshot.rating / 10.0f)
+                        ++torn;
+        });
+    }
+
+    // Rewrites every key and keeps growing the table under the readers
+    for (uint32_t round = 1; round <= 200; ++round)
+    {
+        for (uint64_t key = 1; key <= 64; ++key)
+            index.Publish(key, MakeSnapshot(1000.0f + round));
+
+        index.Publish(1000 + round, MakeSnapshot(1.0f));
+    }
+
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn, 0u);
+}
+
+/// Test 4: Rating sums average over their count and fall back when empty
+TEST(Glicko2RatingIndexTest, RatingSumAverages)
+{
+    Glicko2RatingSum sum;
+    EXPECT_FLOAT_EQ(sum.GetAverageRating(1500.0f), 1500.0f);
+    EXPECT_FLOAT_EQ(sum.GetAverageRatingDeviation(200.0f), 200.0f);
+
+    sum.Add(1400.0f, 100.0f);
+    sum.Add(1700.0f, 50.0f);
+    EXPECT_EQ(sum.count, 2u);
+    EXPECT_FLOAT_EQ(sum.GetAverageRating(1500.0f), 1550.0f);
+    EXPECT_FLOAT_EQ(sum.GetAverageRatingDeviation(200.0f), 75.0f);
+}
@@ -0,0 +1,326 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2ShardedCache.h"
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using TestCache = Glicko2ShardedCache<uint64_t, uint32_t>;
+
+    void Insert(TestCache& cache, uint64_t key, uint32_t value)
+    {
+        TestCache::Shard& shard = cache.GetShard(key);
+        std::unique_lock lock(shard.mutex);
+        shard.map[key] = value;
+    }
+
+    bool Find(TestCache const& cache, uint64_t key, uint32_t& value)
+    {
+        TestCache::Shard const& shard = cache.GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        auto itr = shard.map.find(key);
+        if (itr == shard.map.end())
+            return false;
+
+        value = itr->second;
+        return true;
+    }
+
+    struct LruValue
+    {
+        uint32_t value = 0;
+        bool pinned = false;
+        mutable uint32_t lastAccess = 0;
+    };
+
+    using LruCache = Glicko2ShardedCache<uint64_t, LruValue>;
+
+    /// Inserts through IsFull()/Evict() as the storages do; returns the number evicted
+    std::size_t InsertEvicting(LruCache& cache, uint64_t key, bool pinned = false)
+    {
+        LruCache::Shard& shard = cache.GetShard(key);
+        std::unique_lock lock(shard.mutex);
+
+        std::size_t evicted = 0;
+        if (!shard.map.contains(key) && cache.IsFull(shard))
+            evicted = cache.Evict(shard,
+                [](uint64_t, LruValue const& entry) { return !entry.pinned; },
+                [](uint64_t, LruValue const&) { });
+
+        LruValue& entry = shard.map[key];
+        entry.pinned = pinned;
+        LruCache::Touch(shard, entry.lastAccess);
+        return evicted;
+    }
+
+    bool Lookup(LruCache const& cache, uint64_t key)
+    {
+        LruCache::Shard const& shard = cache.GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        auto itr = shard.map.find(key);
+        LruCache::RecordLookup(shard, itr != shard.map.end());
+        if (itr == shard.map.end())
+            return false;
+
+        LruCache::Touch(shard, itr->second.lastAccess);
+        return true;
+    }
+}
+
+/// Test 1: Shard counts are clamped and consecutive GUIDs reach every shard
+TEST(Glicko2ShardedCacheTest, ShardIndexSpread)
+{
+    EXPECT_EQ(TestCache(0).GetShardCount(), 1u);
+    EXPECT_EQ(TestCache(5000).GetShardCount(), TestCache::MAX_SHARDS);
+
+    TestCache cache(16);
+    std::vector<uint32_t> hits(cache.GetShardCount(), 0);
+    for (uint64_t guid = 1; guid <= 1600; ++guid)
+    {
+        std::size_t index = cache.GetShardIndex(guid);
+        ASSERT_LT(index, cache.GetShardCount());
+        EXPECT_EQ(index, cache.GetShardIndex(guid));
+        ++hits[index];
+    }
+
+    for (uint32_t count : hits)
+        EXPECT_GT(count, 50u);
+}
+
+/// Test 2: Size() and Clear() cover every shard
+TEST(Glicko2ShardedCacheTest, SizeAndClear)
+{
+    TestCache cache(8);
+    for (uint64_t guid = 1; guid <= 100; ++guid)
+        Insert(cache, guid, static_cast<uint32_t>(guid));
+
+    EXPECT_EQ(cache.Size(), 100u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0u);
+}
+
+/// Test 3: Resize() keeps every entry reachable through its new shard
+TEST(Glicko2ShardedCacheTest, ResizeKeepsEntries)
+{
+    TestCache cache(4);
+    for (uint64_t guid = 1; guid <= 500; ++guid)
+        Insert(cache, guid, static_cast<uint32_t>(guid * 3));
+
+    cache.Resize(32);
+    EXPECT_EQ(cache.GetShardCount(), 32u);
+    EXPECT_EQ(cache.Size(), 500u);
+
+    for (uint64_t guid = 1; guid <= 500; ++guid)
+    {
+        uint32_t value = 0;
+        ASSERT_TRUE(Find(cache, guid, value));
+        EXPECT_EQ(value, guid * 3);
+    }
+}
+
+/// Test 4: Concurrent writers on disjoint players lose no updates
+TEST(Glicko2ShardedCacheTest, ConcurrentWriters)
+{
+    constexpr uint64_t PLAYERS_PER_THREAD = 2000;
+    constexpr uint32_t THREADS = 4;
+
+    TestCache cache;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&cache, t]
+        {
+            for (uint64_t i = 0; i < PLAYERS_PER_THREAD; ++i)
+            {
+                uint64_t guid = t * PLAYERS_PER_THREAD + i + 1;
+                Insert(cache, guid, t);
+
+                uint32_t value = 0;
+                Find(cache, guid, value);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(cache.Size(), THREADS * PLAYERS_PER_THREAD);
+}
+
+/// Test 5: A full shard evicts its least recently used entries first and keeps pinned ones
+TEST(Glicko2ShardedCacheTest, EvictsLeastRecentlyUsed)
+{
+    LruCache cache(1);
+    cache.SetCapacity(16);
+    EXPECT_EQ(cache.GetCapacity(), 16u);
+
+    for (uint64_t key = 1; key <= 16; ++key)
+        InsertEvicting(cache, key, key == 1);
+
+    // Reading keys 2..5 makes 6..7 the oldest unpinned entries
+    for (uint64_t key = 2; key <= 5; ++key)
+        EXPECT_TRUE(Lookup(cache, key));
+
+    // Full: make room down to 7/8 of the capacity, then insert
+    EXPECT_EQ(InsertEvicting(cache, 17), 2u);
+    EXPECT_EQ(cache.Size(), 15u);
+
+    EXPECT_TRUE(Lookup(cache, 1));
+    EXPECT_TRUE(Lookup(cache, 2));
+    EXPECT_FALSE(Lookup(cache, 6));
+    EXPECT_FALSE(Lookup(cache, 7));
+    EXPECT_TRUE(Lookup(cache, 8));
+    EXPECT_TRUE(Lookup(cache, 17));
+
+    Glicko2CacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 8u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.evictions, 2u);
+    EXPECT_EQ(stats.entries, 15u);
+    EXPECT_GT(stats.memoryUsage, 0u);
+}
+
+/// Test 6: A shard of pinned entries grows past its share without rescanning on every insert
+TEST(Glicko2ShardedCacheTest, PinnedEntriesOverflow)
+{
+    LruCache cache(1);
+    cache.SetCapacity(16);
+
+    std::size_t evicted = 0;
+    for (uint64_t key = 1; key <= 40; ++key)
+        evicted += InsertEvicting(cache, key, true);
+
+    EXPECT_EQ(evicted, 0u);
+    EXPECT_EQ(cache.Size(), 40u);
+
+    // Unpinned entries go once the next scan is due; the limit is restored
+    for (uint64_t key = 41; key <= 60; ++key)
+        evicted += InsertEvicting(cache, key);
+
+    EXPECT_GT(evicted, 0u);
+    EXPECT_LT(cache.Size(), 60u);
+
+    cache.SetCapacity(0);
+    EXPECT_EQ(cache.GetCapacity(), 0u);
+    for (uint64_t key = 61; key <= 100; ++key)
+        EXPECT_EQ(InsertEvicting(cache, key), 0u);
+}
+
+/// Test 7: LockShards() locks each shard of a batch once and overlapping batches do not deadlock
+TEST(Glicko2ShardedCacheTest, LockShardsForBatch)
+{
+    TestCache cache(8);
+
+    std::vector<uint64_t> keys = { 1, 2, 3, 1, 2, 3 };
+    {
+        auto locks = cache.LockShards(keys);
+        EXPECT_LE(locks.size(), 3u);
+
+        // Probed from another thread: try_lock on a mutex this thread owns is undefined
+        std::thread probe([&cache]
+        {
+            for (uint64_t key = 1; key <= 64; ++key)
+            {
+                bool inBatch = cache.GetShardIndex(key) == cache.GetShardIndex(1) ||
+                    cache.GetShardIndex(key) == cache.GetShardIndex(2) ||
+                    cache.GetShardIndex(key) == cache.GetShardIndex(3);
+
+                std::unique_lock lock(cache.GetShard(key).mutex, std::try_to_lock);
+                EXPECT_EQ(lock.owns_lock(), !inBatch);
+            }
+        });
+        probe.join();
+    }
+
+    // Batches listing the same keys in opposite orders
+    constexpr uint32_t ROUNDS = 2000;
+    std::vector<uint64_t> forward, backward;
+    for (uint64_t key = 1; key <= 32; ++key)
+        forward.push_back(key);
+    backward.assign(forward.rbegin(), forward.rend());
+
+    auto run = [&cache](std::vector<uint64_t> const& batch)
+    {
+        for (uint32_t i = 0; i < ROUNDS; ++i)
+        {
+            auto locks = cache.LockShards(batch);
+            for (uint64_t key : batch)
+                ++cache.GetShard(key).map[key];
+        }
+    };
+
+    std::thread first(run, std::cref(forward));
+    std::thread second(run, std::cref(backward));
+    first.join();
+    second.join();
+
+    for (uint64_t key : forward)
+    {
+        uint32_t value = 0;
+        ASSERT_TRUE(Find(cache, key, value));
+        EXPECT_EQ(value, 2 * ROUNDS);
+    }
+}
+
+/// Test 8: LockAllShared() sees either none or all of a concurrent batch
+TEST(Glicko2ShardedCacheTest, LockAllSharedSnapshot)
+{
+    TestCache cache(8);
+
+    std::vector<uint64_t> batch;
+    for (uint64_t key = 1; key <= 32; ++key)
+        batch.push_back(key);
+
+    constexpr uint32_t ROUNDS = 2000;
+    std::thread writer([&cache, &batch]
+    {
+        for (uint32_t i = 0; i < ROUNDS; ++i)
+        {
+            auto locks = cache.LockShards(batch);
+            for (uint64_t key : batch)
+                ++cache.GetShard(key).map[key];
+        }
+    });
+
+    for (uint32_t i = 0; i < ROUNDS / 4; ++i)
+    {
+        auto locks = cache.LockAllShared();
+        EXPECT_EQ(locks.size(), cache.GetShardCount());
+
+        // Read without Find(): it would take a second shared lock on a held shard
+        auto valueOf = [&cache](uint64_t key)
+        {
+            auto const& map = cache.GetShard(key).map;
+            auto itr = map.find(key);
+            return itr != map.end() ? itr->second : 0u;
+        };
+
+        uint32_t expected = valueOf(batch.front());
+        for (uint64_t key : batch)
+            EXPECT_EQ(valueOf(key), expected);
+    }
+
+    writer.join();
+}
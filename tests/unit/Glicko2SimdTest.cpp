@@ -0,0 +1,166 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2.h"
+#include "Glicko2Simd.h"
+#include <random>
+
+/// Differential tests: SIMD opponent kernels against the scalar UpdateRating
+/// Error bound: 0.01 rating points, 0.01 RD points, 1e-5 volatility
+class Glicko2SimdTest : public ::testing::TestWithParam<Glicko2Simd::Isa>
+{
+protected:
+    void SetUp() override
+    {
+        if (!Glicko2Simd::IsIsaSupported(GetParam()))
+            GTEST_SKIP() << Glicko2Simd::GetIsaName(GetParam()) << " not supported on this host";
+
+        _startupIsa = Glicko2Simd::GetActiveIsa();
+    }
+
+    void TearDown() override
+    {
+        Glicko2Simd::SetActiveIsa(_startupIsa);
+    }
+
+    Glicko2Rating UpdateWith(Glicko2Simd::Isa isa, Glicko2Rating const& player,
+                             std::vector<Glicko2Opponent> const& opponents)
+    {
+        Glicko2Simd::SetActiveIsa(isa);
+        return system.UpdateRating(player, opponents);
+    }
+
+    static constexpr float RATING_TOLERANCE = 0.01f;
+    static constexpr float RD_TOLERANCE = 0.01f;
+    static constexpr float VOLATILITY_TOLERANCE = 0.00001f;
+
+    Glicko2System system{ 0.5f };
+    Glicko2Simd::Isa _startupIsa = Glicko2Simd::Isa::Scalar;
+};
+
+/// Test 1: Random rating periods of every size up to a full 40-man BG
+TEST_P(Glicko2SimdTest, MatchesScalarOnRandomPeriods)
+{
+    std::mt19937 rng(20251016);
+    std::uniform_real_distribution<float> rating(800.0f, 2800.0f);
+    std::uniform_real_distribution<float> rd(30.0f, 350.0f);
+    std::uniform_real_distribution<float> volatility(0.03f, 0.09f);
+    std::uniform_int_distribution<int> outcome(0, 2);
+
+    for (int trial = 0; trial < 500; ++trial)
+    {
+        Glicko2Rating player(rating(rng), rd(rng), volatility(rng));
+
+        std::vector<Glicko2Opponent> opponents;
+        size_t count = 1 + trial % 40;
+        for (size_t i = 0; i < count; ++i)
+            opponents.emplace_back(rating(rng), rd(rng), outcome(rng) * 0.5f);
+
+        Glicko2Rating scalar = UpdateWith(Glicko2Simd::Isa::Scalar, player, opponents);
+        Glicko2Rating simd = UpdateWith(GetParam(), player, opponents);
+
+        ASSERT_NEAR(simd.rating, scalar.rating, RATING_TOLERANCE) << "trial " << trial;
+        ASSERT_NEAR(simd.ratingDeviation, scalar.ratingDeviation, RD_TOLERANCE) << "trial " << trial;
+        ASSERT_NEAR(simd.volatility, scalar.volatility, VOLATILITY_TOLERANCE) << "trial " << trial;
+    }
+}
+
+/// Test 2: Extreme rating gaps exercise the exp range reduction
+TEST_P(Glicko2SimdTest, MatchesScalarOnExtremeRatingGaps)
+{
+    Glicko2Rating player(3000.0f, 50.0f, 0.06f);
+
+    std::vector<Glicko2Opponent> opponents;
+    for (int i = 0; i < 32; ++i)
+        opponents.emplace_back(i % 2 ? 0.0f : 100.0f + i * 10.0f, 30.0f + i * 10.0f, (i % 3) * 0.5f);
+
+    Glicko2Rating scalar = UpdateWith(Glicko2Simd::Isa::Scalar, player, opponents);
+    Glicko2Rating simd = UpdateWith(GetParam(), player, opponents);
+
+    EXPECT_NEAR(simd.rating, scalar.rating, RATING_TOLERANCE);
+    EXPECT_NEAR(simd.ratingDeviation, scalar.ratingDeviation, RD_TOLERANCE);
+    EXPECT_NEAR(simd.volatility, scalar.volatility, VOLATILITY_TOLERANCE);
+}
+
+/// Test 3: Structure-of-arrays batch path uses the same kernels
+TEST_P(Glicko2SimdTest, BatchMatchesScalar)
+{
+    std::vector<float> ratings = { 1500.0f, 1720.0f };
+    std::vector<float> rds = { 200.0f, 80.0f };
+    std::vector<float> vols = { 0.06f, 0.05f };
+    std::vector<size_t> offsets = { 0, 17, 40 };
+
+    std::vector<float> oppRatings, oppRDs, scores;
+    for (int i = 0; i < 40; ++i)
+    {
+        oppRatings.push_back(1300.0f + i * 15.0f);
+        oppRDs.push_back(60.0f + i * 7.0f);
+        scores.push_back(i % 2 ? 1.0f : 0.0f);
+    }
+
+    std::vector<float> scalarRatings = ratings, scalarRDs = rds, scalarVols = vols;
+    Glicko2Simd::SetActiveIsa(Glicko2Simd::Isa::Scalar);
+    system.UpdateRatingsBatch({ scalarRatings, scalarRDs, scalarVols }, { offsets, oppRatings, oppRDs, scores });
+
+    Glicko2Simd::SetActiveIsa(GetParam());
+    system.UpdateRatingsBatch({ ratings, rds, vols }, { offsets, oppRatings, oppRDs, scores });
+
+    for (size_t i = 0; i < ratings.size(); ++i)
+    {
+        EXPECT_NEAR(ratings[i], scalarRatings[i], RATING_TOLERANCE);
+        EXPECT_NEAR(rds[i], scalarRDs[i], RD_TOLERANCE);
+        EXPECT_NEAR(vols[i], scalarVols[i], VOLATILITY_TOLERANCE);
+    }
+}
+
+/// Test 4: Batched predictions match the single-pair API (sizes off the lane width)
+TEST_P(Glicko2SimdTest, PredictionsMatchScalar)
+{
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<float> rating(800.0f, 2800.0f);
+    std::uniform_real_distribution<float> rd(30.0f, 350.0f);
+
+    std::vector<Glicko2Rating> teamsA, teamsB;
+    for (int i = 0; i < 203; ++i)
+    {
+        teamsA.emplace_back(rating(rng), rd(rng), 0.06f);
+        teamsB.emplace_back(rating(rng), rd(rng), 0.06f);
+    }
+
+    Glicko2Simd::SetActiveIsa(GetParam());
+
+    std::vector<float> winProbabilities(teamsA.size());
+    system.WinProbability(teamsA, teamsB, winProbabilities);
+
+    std::vector<float> expectedScores(teamsB.size());
+    system.ExpectedScore(teamsA[0], teamsB, expectedScores);
+
+    Glicko2Simd::SetActiveIsa(Glicko2Simd::Isa::Scalar);
+    for (size_t i = 0; i < teamsA.size(); ++i)
+    {
+        ASSERT_NEAR(winProbabilities[i], system.WinProbability(teamsA[i], teamsB[i]), 0.00001f) << "pair " << i;
+        ASSERT_NEAR(expectedScores[i], system.ExpectedScore(teamsA[0], teamsB[i]), 0.00001f) << "pair " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Glicko2Simd, Glicko2SimdTest,
+    ::testing::Values(Glicko2Simd::Isa::AVX2, Glicko2Simd::Isa::AVX512),
+    [](::testing::TestParamInfo<Glicko2Simd::Isa> const& info)
+    {
+        return info.param == Glicko2Simd::Isa::AVX2 ? "AVX2" : "AVX512";
+    });
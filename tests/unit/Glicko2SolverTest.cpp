@@ -0,0 +1,154 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2.h"
+#include "Glicko2Solver.h"
+#include "Glicko2Static.h"
+#include <random>
+
+/// Test fixture comparing the warm-started solver with the reference one
+class Glicko2SolverTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Glicko2SolverOptions warmStart;
+        warmStart.mode = Glicko2SolverMode::WarmStart;
+        warmStart.maxIterations = 12;
+        warm.SetSolverOptions(warmStart);
+
+        sGlicko2SolverStats->Reset();
+    }
+
+    void TearDown() override
+    {
+        sGlicko2SolverStats->Reset();
+    }
+
+    void ExpectMatchesReference(Glicko2Rating const& player, std::vector<Glicko2Opponent> const& opponents)
+    {
+        Glicko2Rating expected = reference.UpdateRating(player, opponents);
+        Glicko2Rating actual = warm.UpdateRating(player, opponents);
+
+        EXPECT_NEAR(actual.rating, expected.rating, 0.01f);
+        EXPECT_NEAR(actual.ratingDeviation, expected.ratingDeviation, 0.01f);
+        EXPECT_NEAR(actual.volatility, expected.volatility, 0.00001f);
+    }
+
+    Glicko2System reference{ 0.5f };
+    Glicko2System warm{ 0.5f };
+};
+
+/// Test 1: Warm start agrees with the reference solver on random rating periods
+TEST_F(Glicko2SolverTest, WarmStartMatchesReference)
+{
+    std::mt19937 rng(77);
+    std::uniform_real_distribution<float> rating(800.0f, 2800.0f);
+    std::uniform_real_distribution<float> rd(30.0f, 350.0f);
+    std::uniform_real_distribution<float> volatility(0.03f, 0.09f);
+    std::uniform_int_distribution<int> outcome(0, 2);
+
+    for (int trial = 0; trial < 1000; ++trial)
+    {
+        Glicko2Rating player(rating(rng), rd(rng), volatility(rng));
+        std::vector<Glicko2Opponent> opponents;
+        for (int i = 0; i <= trial % 40; ++i)
+            opponents.emplace_back(rating(rng), rd(rng), outcome(rng) * 0.5f);
+
+        ExpectMatchesReference(player, opponents);
+    }
+
+    EXPECT_EQ(sGlicko2SolverStats->GetSnapshot().capped, 0u);
+}
+
+/// Test 2: Pathological deltas (huge upsets, tiny RDs, extreme volatility)
+TEST_F(Glicko2SolverTest, WarmStartMatchesReferenceOnPathologicalDeltas)
+{
+    // Lowest rated, most certain player beats a wall of 2800s
+    std::vector<Glicko2Opponent> upsets(20, Glicko2Opponent(2800.0f, 30.0f, 1.0f));
+    ExpectMatchesReference(Glicko2Rating(800.0f, 30.0f, 0.03f), upsets);
+
+    // Expected results only: delta close to zero
+    std::vector<Glicko2Opponent> expected(20, Glicko2Opponent(800.0f, 30.0f, 1.0f));
+    ExpectMatchesReference(Glicko2Rating(2800.0f, 30.0f, 0.06f), expected);
+
+    // Highly volatile newcomer
+    std::vector<Glicko2Opponent> single = { Glicko2Opponent(1500.0f, 350.0f, 0.0f) };
+    ExpectMatchesReference(Glicko2Rating(1500.0f, 350.0f, 0.3f), single);
+
+    EXPECT_EQ(sGlicko2SolverStats->GetSnapshot().capped, 0u);
+}
+
+/// Test 3: The iteration cap is never exceeded and capped solves are counted
+TEST_F(Glicko2SolverTest, IterationCapIsHonoured)
+{
+    Glicko2SolverOptions tight;
+    tight.mode = Glicko2SolverMode::WarmStart;
+    tight.maxIterations = 1;
+    warm.SetSolverOptions(tight);
+
+    std::vector<Glicko2Opponent> upsets(20, Glicko2Opponent(2800.0f, 30.0f, 1.0f));
+    Glicko2Rating rating = warm.UpdateRating(Glicko2Rating(800.0f, 30.0f, 0.03f), upsets);
+
+    Glicko2SolverStats::Snapshot stats = sGlicko2SolverStats->GetSnapshot();
+    EXPECT_EQ(stats.calls, 1u);
+    EXPECT_EQ(stats.capped, 1u);
+    EXPECT_EQ(stats.iterations[1], 1u);
+    EXPECT_TRUE(std::isfinite(rating.volatility));
+    EXPECT_GT(rating.volatility, 0.0f);
+}
+
+/// Test 4: Every solve lands in the histogram, from both system types
+TEST_F(Glicko2SolverTest, HistogramCountsEverySolve)
+{
+    Glicko2DefaultSystem fixed;
+    std::vector<Glicko2Opponent> opponents = { Glicko2Opponent(1400.0f, 30.0f, 1.0f) };
+
+    for (int i = 0; i < 5; ++i)
+        reference.UpdateRating(Glicko2Rating(), opponents);
+    for (int i = 0; i < 3; ++i)
+        fixed.UpdateRating(Glicko2Rating(), opponents);
+
+    // Inactive players never reach the solver
+    reference.UpdateInactiveRating(Glicko2Rating());
+
+    Glicko2SolverStats::Snapshot stats = sGlicko2SolverStats->GetSnapshot();
+    EXPECT_EQ(stats.calls, 8u);
+
+    uint64_t total = 0;
+    for (uint64_t count : stats.iterations)
+        total += count;
+    EXPECT_EQ(total, 8u);
+    EXPECT_GT(stats.maxEvaluations, 0u);
+
+    sGlicko2SolverStats->Reset();
+    EXPECT_EQ(sGlicko2SolverStats->GetSnapshot().calls, 0u);
+}
+
+/// Test 5: The reference solver terminates when float precision stalls |B - A| above ε
+TEST_F(Glicko2SolverTest, ReferenceTerminatesOnStalledBracket)
+{
+    // A 3200 player dropping 28 games to 825s used to spin forever
+    std::vector<Glicko2Opponent> upsets(28, Glicko2Opponent(825.51f, 140.711f, 0.0f));
+    Glicko2Rating rating = reference.UpdateRating(Glicko2Rating(3192.618f, 245.142f, 0.09356f), upsets);
+
+    EXPECT_TRUE(std::isfinite(rating.volatility));
+    EXPECT_GT(rating.volatility, 0.09356f);
+    EXPECT_LT(rating.rating, 3192.618f);
+    EXPECT_LE(sGlicko2SolverStats->GetSnapshot().iterations[Glicko2SolverStats::BUCKETS - 1], 1u);
+}
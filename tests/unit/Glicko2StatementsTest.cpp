@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2Statements.h"
+#include <limits>
+#include <string>
+
+/// Test 1: Every registered statement fits MAX_PARAMETERS and renders without a leftover placeholder
+TEST(Glicko2StatementsTest, EveryStatementRenders)
+{
+    for (uint8_t index = 0; index < MAX_GLICKO2_STATEMENTS; ++index)
+    {
+        Glicko2SqlBuilder stmt(static_cast<Glicko2Statements>(index));
+        for (uint8_t parameter = 0; parameter < Glicko2SqlBuilder::MAX_PARAMETERS; ++parameter)
+            stmt.SetData(parameter, uint32_t(1));
+
+        std::string sql = stmt.GetSql();
+        EXPECT_FALSE(sql.empty());
+        EXPECT_EQ(sql.find('?'), std::string::npos) << sql;
+    }
+}
+
+/// Test 2: Bound values are rendered in place of the placeholders
+TEST(Glicko2StatementsTest, RendersBoundValues)
+{
+    Glicko2SqlBuilder stmt(GLICKO2_SEL_ARENA_RATING);
+    stmt.SetData(0, uint32_t(4242));
+    stmt.SetData(1, uint8_t(2));
+
+    std::string sql = stmt.GetSql();
+    EXPECT_NE(sql.find("WHERE guid = 4242 AND slot = 2"), std::string::npos);
+    EXPECT_EQ(sql.find('?'), std::string::npos);
+}
+
+/// Test 3: Floats keep their shortest round-trip text, signed values their sign
+TEST(Glicko2StatementsTest, RendersNumericTypes)
+{
+    Glicko2SqlBuilder stmt(GLICKO2_INS_BG_RATING_HISTORY);
+    stmt.SetData(0, uint32_t(7));
+    stmt.SetData(1, 1612.25f);
+    stmt.SetData(2, 0.06f);
+    stmt.SetData(3, 0.5);
+    stmt.SetData(4, int32_t(-3));
+    stmt.SetData(5, true);
+
+    std::string sql = stmt.GetSql();
+    EXPECT_NE(sql.find("VALUES (7, 1612.25, 0.06, 0.5, -3, 1)"), std::string::npos);
+}
+
+/// Test 4: Rebinding a parameter replaces its value, unbound ones render as NULL
+TEST(Glicko2StatementsTest, RebindAndUnbound)
+{
+    Glicko2SqlBuilder stmt(GLICKO2_DEL_BG_RATING);
+    EXPECT_EQ(stmt.GetSql(), "DELETE FROM character_battleground_rating WHERE guid = NULL");
+
+    stmt.SetData(0, uint32_t(1));
+    stmt.SetData(0, uint32_t(99));
+    EXPECT_EQ(stmt.GetSql(), "DELETE FROM character_battleground_rating WHERE guid = 99");
+}
+
+/// Test 5: NaN and infinity have no SQL literal and render as NULL
+TEST(Glicko2StatementsTest, NonFiniteRendersNull)
+{
+    Glicko2SqlBuilder stmt(GLICKO2_INS_BG_RATING_HISTORY);
+    stmt.SetData(0, uint32_t(7));
+    stmt.SetData(1, std::numeric_limits<float>::quiet_NaN());
+    stmt.SetData(2, std::numeric_limits<float>::infinity());
+    stmt.SetData(3, -std::numeric_limits<double>::infinity());
+    stmt.SetData(4, uint32_t(0));
+    stmt.SetData(5, uint8_t(1));
+
+    std::string sql = stmt.GetSql();
+    EXPECT_NE(sql.find("VALUES (7, NULL, NULL, NULL, 0, 1)"), std::string::npos);
+}
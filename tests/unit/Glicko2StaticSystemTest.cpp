@@ -0,0 +1,121 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "Glicko2.h"
+#include "Glicko2Static.h"
+#include "Glicko2Simd.h"
+#include <array>
+#include <random>
+
+namespace
+{
+    /// g(φ) for RD 0, 50, ..., 350, built entirely at compile time
+    constexpr std::array<float, 8> BuildGTable()
+    {
+        std::array<float, 8> table{};
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = Glicko2Constexpr::CalculateG(Glicko2Constexpr::ConvertRDToGlicko2(50.0f * i));
+        return table;
+    }
+
+    constexpr std::array<float, 8> G_TABLE = BuildGTable();
+
+    static_assert(G_TABLE[0] == 1.0f, "g(0) must be 1");
+    static_assert(G_TABLE[7] > 0.66f && G_TABLE[7] < 0.67f, "g(phi) for RD 350 is about 0.6690");
+    static_assert(Glicko2DefaultSystem::INV_TAU_SQUARED == 4.0f, "1/tau^2 folds to 4 for tau = 0.5");
+}
+
+/// Test fixture comparing the compile-time system with the runtime one
+class Glicko2StaticSystemTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Compare against the scalar runtime path; the SIMD kernels sum in a different order
+        _startupIsa = Glicko2Simd::GetActiveIsa();
+        Glicko2Simd::SetActiveIsa(Glicko2Simd::Isa::Scalar);
+    }
+
+    void TearDown() override
+    {
+        Glicko2Simd::SetActiveIsa(_startupIsa);
+    }
+
+    Glicko2System runtime{ 0.5f };
+    Glicko2DefaultSystem fixed;
+    Glicko2Simd::Isa _startupIsa = Glicko2Simd::Isa::Scalar;
+};
+
+/// Test 1: Constexpr conversion layer agrees with the runtime system's scale
+TEST_F(Glicko2StaticSystemTest, ConstexprTableMatchesRuntimeG)
+{
+    for (size_t i = 0; i < G_TABLE.size(); ++i)
+    {
+        Glicko2PreparedOpponent prepared = runtime.PrepareOpponent(Glicko2Opponent(1500.0f, 50.0f * i, 1.0f));
+        EXPECT_NEAR(G_TABLE[i], prepared.gPhi, 1e-6f) << "RD " << 50.0f * i;
+    }
+}
+
+/// Test 2: Glickman's paper example with the float and double specializations
+TEST_F(Glicko2StaticSystemTest, MatchesGlickmanPaperExample)
+{
+    using DoubleSystem = Glicko2StaticSystem<std::ratio<1, 2>, std::ratio<1, 1000000>, double>;
+
+    Glicko2Rating player(1500.0f, 200.0f, 0.06f);
+    std::vector<Glicko2Opponent> opponents;
+    opponents.emplace_back(1400.0f, 30.0f, 1.0f);
+    opponents.emplace_back(1550.0f, 100.0f, 0.0f);
+    opponents.emplace_back(1700.0f, 300.0f, 0.0f);
+
+    Glicko2Rating single = fixed.UpdateRating(player, opponents);
+    Glicko2Rating precise = DoubleSystem().UpdateRating(player, opponents);
+
+    EXPECT_NEAR(single.rating, 1464.06f, 0.1f);
+    EXPECT_NEAR(single.ratingDeviation, 151.52f, 0.1f);
+    EXPECT_NEAR(precise.rating, 1464.06f, 0.01f);
+    EXPECT_NEAR(precise.ratingDeviation, 151.52f, 0.01f);
+    EXPECT_NEAR(precise.volatility, 0.05999f, 0.00001f);
+}
+
+/// Test 3: Same results as the runtime system on random rating periods
+TEST_F(Glicko2StaticSystemTest, MatchesRuntimeSystem)
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> rating(800.0f, 2800.0f);
+    std::uniform_real_distribution<float> rd(30.0f, 350.0f);
+    std::uniform_int_distribution<int> outcome(0, 2);
+
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        Glicko2Rating player(rating(rng), rd(rng), 0.06f);
+        std::vector<Glicko2Opponent> opponents;
+        for (int i = 0; i <= trial % 15; ++i)
+            opponents.emplace_back(rating(rng), rd(rng), outcome(rng) * 0.5f);
+
+        Glicko2Rating expected = runtime.UpdateRating(player, opponents);
+        Glicko2Rating actual = fixed.UpdateRating(player, opponents);
+
+        ASSERT_NEAR(actual.rating, expected.rating, 0.01f) << "trial " << trial;
+        ASSERT_NEAR(actual.ratingDeviation, expected.ratingDeviation, 0.01f) << "trial " << trial;
+        ASSERT_NEAR(actual.volatility, expected.volatility, 0.00001f) << "trial " << trial;
+    }
+
+    Glicko2Rating idle(1600.0f, 80.0f, 0.06f);
+    EXPECT_FLOAT_EQ(fixed.UpdateInactiveRating(idle).ratingDeviation,
+                    runtime.UpdateInactiveRating(idle).ratingDeviation);
+}
@@ -268,3 +268,126 @@ TEST_F(Glicko2SystemTest, NoOpponentsIncreasesRD)
     EXPECT_GT(newRating.ratingDeviation, player.ratingDeviation) << "RD should increase during inactivity";
     EXPECT_FLOAT_EQ(newRating.volatility, player.volatility) << "Volatility unchanged without matches";
 }
+
+/// Test 15: Worked example from Glickman's Glicko-2 paper (multi-opponent period)
+TEST_F(Glicko2SystemTest, MatchesGlickmanPaperExample)
+{
+    Glicko2Rating player(1500.0f, 200.0f, 0.06f);
+    std::vector<Glicko2Opponent> opponents;
+    opponents.emplace_back(1400.0f, 30.0f, 1.0f);
+    opponents.emplace_back(1550.0f, 100.0f, 0.0f);
+    opponents.emplace_back(1700.0f, 300.0f, 0.0f);
+
+    Glicko2Rating newRating = system->UpdateRating(player, opponents);
+
+    ExpectNear(newRating.rating, 1464.06f, 0.1f);
+    ExpectNear(newRating.ratingDeviation, 151.52f, 0.1f);
+    EXPECT_NEAR(newRating.volatility, 0.05999f, 0.0001f);
+}
+
+/// Test 16: Batch update matches per-player updates, including an idle player
+TEST_F(Glicko2SystemTest, BatchUpdateMatchesPerPlayerUpdates)
+{
+    std::vector<Glicko2Rating> players = {
+        { 1500.0f, 200.0f, 0.06f },
+        { 1820.0f, 90.0f, 0.05f },
+        { 1310.0f, 340.0f, 0.07f },
+    };
+
+    // Player 0 plays three opponents, player 1 is idle, player 2 plays one
+    std::vector<size_t> offsets = { 0, 3, 3, 4 };
+    std::vector<float> oppRatings = { 1400.0f, 1550.0f, 1700.0f, 1500.0f };
+    std::vector<float> oppRDs = { 30.0f, 100.0f, 300.0f, 200.0f };
+    std::vector<float> scores = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+    std::vector<float> ratings, rds, vols;
+    for (auto const& p : players)
+    {
+        ratings.push_back(p.rating);
+        rds.push_back(p.ratingDeviation);
+        vols.push_back(p.volatility);
+    }
+
+    system->UpdateRatingsBatch({ ratings, rds, vols }, { offsets, oppRatings, oppRDs, scores });
+
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        std::vector<Glicko2Opponent> opponents;
+        for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+            opponents.emplace_back(oppRatings[j], oppRDs[j], scores[j]);
+
+        Glicko2Rating expected = system->UpdateRating(players[i], opponents);
+        EXPECT_FLOAT_EQ(ratings[i], expected.rating);
+        EXPECT_FLOAT_EQ(rds[i], expected.ratingDeviation);
+        EXPECT_FLOAT_EQ(vols[i], expected.volatility);
+    }
+}
+
+/// Test 17: Prepared opponents give the same result as raw opponents
+TEST_F(Glicko2SystemTest, PreparedOpponentsMatchRawOpponents)
+{
+    Glicko2Rating player(1500.0f, 200.0f, 0.06f);
+    std::vector<Glicko2Opponent> opponents;
+    opponents.emplace_back(1400.0f, 30.0f, 1.0f);
+    opponents.emplace_back(1550.0f, 100.0f, 0.0f);
+    opponents.emplace_back(1700.0f, 300.0f, 0.0f);
+
+    std::vector<Glicko2PreparedOpponent> prepared;
+    for (auto const& opponent : opponents)
+        prepared.push_back(system->PrepareOpponent(opponent));
+
+    Glicko2Rating expected = system->UpdateRating(player, opponents);
+    Glicko2Rating actual = system->UpdateRating(player, prepared);
+
+    EXPECT_FLOAT_EQ(actual.rating, expected.rating);
+    EXPECT_FLOAT_EQ(actual.ratingDeviation, expected.ratingDeviation);
+    EXPECT_FLOAT_EQ(actual.volatility, expected.volatility);
+
+    // A whole team against one prepared side
+    std::vector<float> ratings = { 1500.0f, 1650.0f };
+    std::vector<float> rds = { 200.0f, 120.0f };
+    std::vector<float> vols = { 0.06f, 0.06f };
+    system->UpdateRatingsBatch({ ratings, rds, vols }, prepared[1]);
+
+    Glicko2Rating second = system->UpdateRating(Glicko2Rating(1650.0f, 120.0f, 0.06f), { opponents[1] });
+    EXPECT_FLOAT_EQ(ratings[1], second.rating);
+    EXPECT_FLOAT_EQ(rds[1], second.ratingDeviation);
+}
+
+/// Test 18: Closed-form inactivity matches repeated single periods and honours the cap
+TEST_F(Glicko2SystemTest, ClosedFormInactivityMatchesRepeatedPeriods)
+{
+    Glicko2Rating player(1700.0f, 60.0f, 0.06f);
+
+    Glicko2Rating stepped = player;
+    for (int i = 0; i < 10; ++i)
+        stepped = system->UpdateInactiveRating(stepped);
+
+    Glicko2Rating closedForm = system->UpdateInactiveRating(player, 10, 350.0f);
+    EXPECT_NEAR(closedForm.ratingDeviation, stepped.ratingDeviation, 0.01f);
+    EXPECT_FLOAT_EQ(closedForm.rating, player.rating);
+    EXPECT_FLOAT_EQ(closedForm.volatility, player.volatility);
+
+    EXPECT_FLOAT_EQ(system->UpdateInactiveRating(player, 0, 350.0f).ratingDeviation, 60.0f);
+    EXPECT_FLOAT_EQ(system->UpdateInactiveRating(player, 100000, 350.0f).ratingDeviation, 350.0f);
+}
+
+/// Test 19: Expected score and win probability (Glickman's example values)
+TEST_F(Glicko2SystemTest, ExpectedScoreAndWinProbability)
+{
+    Glicko2Rating player(1500.0f, 200.0f, 0.06f);
+
+    ExpectNear(system->ExpectedScore(player, Glicko2Rating(1400.0f, 30.0f, 0.06f)), 0.639f, 0.001f);
+    ExpectNear(system->ExpectedScore(player, Glicko2Rating(1550.0f, 100.0f, 0.06f)), 0.432f, 0.001f);
+    ExpectNear(system->ExpectedScore(player, Glicko2Rating(1700.0f, 300.0f, 0.06f)), 0.303f, 0.001f);
+
+    Glicko2Rating strong(1800.0f, 80.0f, 0.06f);
+    Glicko2Rating weak(1500.0f, 80.0f, 0.06f);
+    EXPECT_FLOAT_EQ(system->WinProbability(player, player), 0.5f);
+    EXPECT_GT(system->WinProbability(strong, weak), 0.5f);
+    EXPECT_NEAR(system->WinProbability(strong, weak) + system->WinProbability(weak, strong), 1.0f, 0.00001f);
+
+    // More uncertainty on either side pulls the prediction toward a coin flip
+    Glicko2Rating uncertainWeak(1500.0f, 350.0f, 0.06f);
+    EXPECT_LT(system->WinProbability(strong, uncertainWeak), system->WinProbability(strong, weak));
+}